@@ -0,0 +1,333 @@
+#include "colex.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace colex;
+
+/**
+ * Runs `func` `repetitions` times and prints the fastest run.
+ * The result of `func` is accumulated so the work can't be optimized away.
+ */
+template<typename F>
+void bench(const char *name, size_t repetitions, F func) {
+  using clock = std::chrono::steady_clock;
+
+  auto best = clock::duration::max();
+  long long sink = 0;
+
+  for (size_t i = 0; i < repetitions; ++i) {
+    auto start = clock::now();
+    sink += static_cast<long long>(func());
+    best = std::min(best, clock::now() - start);
+  }
+
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(best);
+  std::printf("%-40s %10lld us   (%lld)\n", name,
+              static_cast<long long>(us.count()), sink);
+}
+
+int main() {
+  constexpr size_t n = 1 << 24;
+  constexpr size_t repetitions = 10;
+
+  std::vector<int> xs(n);
+  std::iota(xs.begin(), xs.end(), 0);
+
+  std::printf("map | filter | fold over %zu ints\n", n);
+
+  bench("hand written loop", repetitions, [&] {
+    long long acc = 0;
+    for (int x : xs) {
+      int y = x * 3;
+      if (y % 7 != 0) { acc += y; }
+    }
+    return acc;
+  });
+
+  bench("pipeline over iter(ptr, n)", repetitions, [&] {
+    return iter(xs.data(), xs.size()) | map([](int x) { return x * 3; })
+         | filter([](int y) { return y % 7 != 0; })
+         | fold(0LL, [](long long acc, int y) { return acc + y; });
+  });
+
+  bench("pipeline over iter(vector)", repetitions, [&] {
+    return iter(xs) | map([](int x) { return x * 3; })
+         | filter([](int y) { return y % 7 != 0; })
+         | fold(0LL, [](long long acc, int y) { return acc + y; });
+  });
+
+  bench("pipeline through next()", repetitions, [&] {
+    auto it = iter(xs) | map([](int x) { return x * 3; })
+            | filter([](int y) { return y % 7 != 0; });
+
+    long long acc = 0;
+    for (auto y = it.next(); y.has_value(); y = it.next()) { acc += *y; }
+    return acc;
+  });
+
+  std::printf("\nsum over %zu ints\n", n);
+
+  bench("fold", repetitions, [&] {
+    return iter(xs) | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  bench("sum()", repetitions, [&] { return iter(xs) | sum(); });
+
+  bench("fold(std::plus)", repetitions, [&] {
+    return iter(xs) | fold(0, std::plus<int>());
+  });
+
+  bench("hand written min", repetitions, [&] {
+    int smallest = xs[0];
+    for (int x : xs) { smallest = x < smallest ? x : smallest; }
+    return smallest;
+  });
+
+  bench("min()", repetitions, [&] { return *(iter(xs) | min()); });
+
+  std::printf("\nkernels over %zu ints, best is %s\n", n,
+              kernel::isa_name(kernel::best_supported_isa()));
+
+  for (kernel::Isa isa : {kernel::Isa::Scalar, kernel::Isa::Sse2,
+                          kernel::Isa::Avx2, kernel::Isa::Avx512}) {
+    if (!kernel::use_isa(isa)) { continue; }
+
+    std::string name = std::string(kernel::isa_name(isa));
+    bench((name + " sum").c_str(), repetitions, [&] { return iter(xs) | sum(); });
+    bench((name + " min").c_str(), repetitions, [&] { return *(iter(xs) | min()); });
+    bench((name + " count").c_str(), repetitions, [&] {
+      return kernel::count(xs.data(), xs.size(), 12345);
+    });
+  }
+
+  kernel::use_isa(kernel::best_supported_isa());
+
+  bench("par_reduce", repetitions, [&] {
+    return iter(xs) | par_reduce(0LL, [](long long acc, int x) { return acc + x; },
+                                 std::plus<long long>());
+  });
+
+  std::printf("\nmap | collect<std::vector> over %zu ints\n", n);
+
+  bench("hand written loop", repetitions, [&] {
+    std::vector<int> ys;
+    ys.reserve(xs.size());
+    for (int x : xs) { ys.push_back(x * 3); }
+    return ys.back();
+  });
+
+  bench("pipeline over iter(ptr, n)", repetitions, [&] {
+    auto ys = iter(xs.data(), xs.size()) | map([](int x) { return x * 3; })
+            | collect<std::vector>();
+    return ys.back();
+  });
+
+  std::printf("\nwindow<64> | map | fold over %zu ints\n", n);
+
+  bench("hand written loop", repetitions, [&] {
+    long long acc = 0;
+    for (size_t i = 0; i + 64 <= xs.size(); ++i) { acc += xs[i] ^ xs[i + 63]; }
+    return acc;
+  });
+
+  bench("pipeline over iter(vector)", repetitions, [&] {
+    return iter(xs) | window<64>() | map([](auto w) { return w.front() ^ w.back(); })
+         | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  bench("pipeline over range", repetitions, [&] {
+    return range(0, int(n)) | window<64>() | map([](auto w) { return w.front() ^ w.back(); })
+         | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  std::vector<int> percents(n);
+  std::mt19937 random(42);
+  for (int &x : percents) { x = int(random() % 100); }
+
+  std::printf("\nfilter | collect<std::vector> over %zu ints\n", n);
+
+  for (int selectivity : {1, 10, 25, 50, 75, 90, 99}) {
+    auto keep = [selectivity](int x) { return x < selectivity; };
+    std::string suffix = " " + std::to_string(selectivity) + "%";
+
+    bench(("hand written loop" + suffix).c_str(), repetitions, [&] {
+      std::vector<int> ys;
+      for (int x : percents) {
+        if (keep(x)) { ys.push_back(x); }
+      }
+      return ys.size();
+    });
+
+    bench(("pipeline" + suffix).c_str(), repetitions, [&] {
+      return (iter(percents) | filter(keep) | collect<std::vector>()).size();
+    });
+
+    kernel::use_isa(kernel::Isa::Scalar);
+    bench(("pipeline, scalar kernels" + suffix).c_str(), repetitions, [&] {
+      return (iter(percents) | filter(keep) | collect<std::vector>()).size();
+    });
+    kernel::use_isa(kernel::best_supported_isa());
+  }
+
+  std::printf("\ngather of every third of %zu ints\n", n);
+
+  bench("hand written loop", repetitions, [&] {
+    int acc = 0;
+    for (size_t i = 0; i < n; i += 3) { acc += xs[i]; }
+    return acc;
+  });
+
+  bench("range | map(gather) | sum()", repetitions, [&] {
+    return range(size_t(0), n, size_t(3)) | map([&](size_t i) { return xs[i]; }) | sum();
+  });
+
+  constexpr size_t keys = 1 << 20;
+  std::printf("\ncollect<std::set> of %zu sorted ints\n", keys);
+
+  bench("insert one by one", repetitions, [&] {
+    return (iter(xs.data(), keys) | collect<std::set>()).size();
+  });
+
+  bench("assume_sorted()", repetitions, [&] {
+    return (iter(xs.data(), keys) | assume_sorted() | collect<std::set>()).size();
+  });
+
+  std::set<int> sorted_keys(xs.begin(), xs.begin() + keys);
+  bench("from std::set", repetitions, [&] {
+    return (iter(sorted_keys) | collect<std::set>()).size();
+  });
+
+  std::printf("\n%zu lookups in a table of %zu ints\n", keys, keys);
+
+  std::vector<int> probes(keys);
+  for (int &x : probes) { x = int(random() % (2 * keys)); }
+
+  auto tree = iter(xs.data(), keys) | map([](int x) { return std::pair(x, x); })
+            | collect<std::map>();
+  bench("collect<std::map>", 1, [&] {
+    size_t hits = 0;
+    for (int x : probes) { hits += tree.count(x); }
+    return hits;
+  });
+
+  auto flat = iter(xs.data(), keys) | map([](int x) { return std::pair(x, x); })
+            | collect<container::flat_map>();
+  bench("collect<container::flat_map>", 1, [&] {
+    size_t hits = 0;
+    for (int x : probes) { hits += flat.count(x); }
+    return hits;
+  });
+
+  std::printf("\nchunk_map(4096, sum()) over %zu ints\n", n);
+
+  bench("hand written loop", repetitions, [&] {
+    long long acc = 0;
+    for (size_t i = 0; i < xs.size(); i += 4096) {
+      size_t end = std::min(xs.size(), i + 4096);
+      acc += std::accumulate(xs.begin() + i, xs.begin() + end, 0);
+    }
+    return acc;
+  });
+
+  bench("pipeline over iter(vector)", repetitions, [&] {
+    return iter(xs) | chunk_map(4096, sum())
+         | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  bench("pipeline over iter(vector) | map", repetitions, [&] {
+    return iter(xs) | map([](int x) { return x; }) | chunk_map(4096, sum())
+         | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  bench("par_chunk_map(4096, sum())", repetitions, [&] {
+    return iter(xs) | par_chunk_map(4096, sum())
+         | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  bench("par_chunk_map(4096, expensive fold)", repetitions, [&] {
+    return iter(xs)
+         | par_chunk_map(4096, fold(0, [](int acc, int x) { return acc + x / 7 % 5; }))
+         | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  bench("chunk_map(4096, expensive fold)", repetitions, [&] {
+    return iter(xs)
+         | chunk_map(4096, fold(0, [](int acc, int x) { return acc + x / 7 % 5; }))
+         | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  constexpr size_t width = 1024;
+  std::printf("\nrolling aggregates of %zu wide windows over %zu ints\n", width, n);
+
+  bench("window(1024) | map(max_element)", 1, [&] {
+    return iter(percents) | window(width)
+         | map([](auto w) { return *std::max_element(w.begin(), w.end()); })
+         | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  bench("rolling_max(1024)", repetitions, [&] {
+    return iter(percents) | rolling_max(width)
+         | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  bench("window(1024) | map(accumulate)", 1, [&] {
+    return iter(percents) | window(width)
+         | map([](auto w) { return std::accumulate(w.begin(), w.end(), 0); })
+         | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  bench("rolling_sum(1024)", repetitions, [&] {
+    return iter(percents) | rolling_sum(width)
+         | fold(0LL, [](long long acc, int x) { return acc + x; });
+  });
+
+  std::printf("\ncopying %zu ints\n", n);
+
+  bench("collect<std::vector>()", repetitions, [&] {
+    return (iter(xs) | collect<std::vector>()).size();
+  });
+
+  std::vector<int> reused;
+  bench("collect_into(reused)", repetitions, [&] {
+    reused.clear();
+    return (iter(xs) | collect_into(reused)).size();
+  });
+
+  std::vector<int> buffer(n);
+  bench("write_to", repetitions, [&] {
+    return iter(xs) | write_to(buffer.data(), buffer.size());
+  });
+
+  bench("write_to, non-temporal", repetitions, [&] {
+    return iter(xs) | write_to(buffer.data(), buffer.size(), Store::NonTemporal);
+  });
+
+  constexpr size_t lists = 1 << 20;
+  std::printf("\nflat_map over %zu initializer lists\n", lists);
+
+  auto pairs = [&] {
+    return iter(xs.data(), lists) | flat_map([](int x) { return iter({x, -x, x}); }) | sum();
+  };
+
+  bench("default resource", repetitions, pairs);
+
+  bench("with_resource(monotonic arena)", repetitions, [&] {
+    std::pmr::monotonic_buffer_resource arena(1 << 16);
+    return with_resource(&arena, pairs);
+  });
+
+  bench("iter_inline<3>", repetitions, [&] {
+    return iter(xs.data(), lists)
+           | flat_map([](int x) { return iter_inline<3>({x, -x, x}); }) | sum();
+  });
+
+  return 0;
+}
@@ -2,6 +2,18 @@
 
 namespace colex {
 
+expression::Count count() {
+  return expression::Count();
+}
+
+expression::Sorted sorted() {
+  return expression::Sorted();
+}
+
+expression::AssumeSorted assume_sorted() {
+  return expression::AssumeSorted();
+}
+
 expression::Take take(size_t count) {
   return expression::Take(count);
 }
@@ -14,10 +26,42 @@ expression::Enumerate enumerate() {
   return expression::Enumerate();
 }
 
+expression::Sum sum() { return expression::Sum(); }
+
+expression::Min min() { return expression::Min(); }
+
+expression::Max max() { return expression::Max(); }
+
+expression::MinMax minmax() { return expression::MinMax(); }
+
+expression::Copied copied() {
+  return expression::Copied();
+}
+
 expression::Composition<expression::Drop, expression::Take> slice(size_t start, size_t count) {
   return expression::Composition<expression::Drop, expression::Take>(drop(start), take(count));
 }
 
+expression::DynamicWindow window(size_t size, size_t hop) {
+  return expression::DynamicWindow(size, hop);
+}
+
+expression::RollingSum rolling_sum(size_t window) {
+  return expression::RollingSum(window);
+}
+
+expression::RollingMean rolling_mean(size_t window) {
+  return expression::RollingMean(window);
+}
+
+expression::RollingMin rolling_min(size_t window) {
+  return expression::RollingMin(window);
+}
+
+expression::RollingMax rolling_max(size_t window) {
+  return expression::RollingMax(window);
+}
+
 expression::Chunk chunk(size_t size) {
   return expression::Chunk(size);
 }
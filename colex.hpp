@@ -1,5 +1,7 @@
 #pragma once
 
+#include "containers/inc/containers.hpp"
+#include "executors/inc/executors.hpp"
 #include "expressions/inc/expressions.hpp"
 
 #include <cstddef>
@@ -7,6 +9,10 @@
 #include <initializer_list>
 #include <unordered_set>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -20,6 +26,24 @@ expression::Map<F> map(F func) {
   return expression::Map<F>(func);
 }
 
+/**
+ * Creates a parallel map expression evaluated on `pool`. See README for details
+ */
+template<typename F>
+expression::ParMap<F> par_map(F func, executor::ThreadPool &pool,
+                              size_t morsel_size = 256) {
+  return expression::ParMap<F>(std::move(func), pool, morsel_size);
+}
+
+/**
+ * Creates a parallel map expression evaluated on the default pool.
+ * See README for details
+ */
+template<typename F>
+expression::ParMap<F> par_map(F func) {
+  return par_map(std::move(func), executor::default_pool());
+}
+
 /**
  * Creates a filter expression. See README for details
  */
@@ -44,6 +68,55 @@ expression::Scan<T, F> scan(T initial, F func) {
   return expression::Scan<T, F>(initial, std::move(func));
 }
 
+/**
+ * Creates a parallel reduce expression evaluated on `pool`.
+ * See README for details
+ */
+template<typename T, typename F, typename G>
+expression::ParReduce<T, F, G> par_reduce(T identity, F func, G combine,
+                                          executor::ThreadPool &pool,
+                                          size_t morsel_size = 4096) {
+  return expression::ParReduce<T, F, G>(std::move(identity), std::move(func),
+                                        std::move(combine), pool, morsel_size);
+}
+
+/**
+ * Creates a parallel reduce expression evaluated on the default pool.
+ * See README for details
+ */
+template<typename T, typename F, typename G>
+expression::ParReduce<T, F, G> par_reduce(T identity, F func, G combine) {
+  return par_reduce(std::move(identity), std::move(func), std::move(combine),
+                    executor::default_pool());
+}
+
+/**
+ * Creates a sum expression. See README for details
+ */
+expression::Sum sum();
+
+/**
+ * Creates an expression finding the smallest element. See README for details
+ */
+expression::Min min();
+
+/**
+ * Creates an expression finding the largest element. See README for details
+ */
+expression::Max max();
+
+/**
+ * Creates an expression finding both the smallest and the largest element.
+ * See README for details
+ */
+expression::MinMax minmax();
+
+/**
+ * Function objects for `fold` and `fold1`. See README for details
+ */
+using expression::Minimum;
+using expression::Maximum;
+
 /**
  * Creates a fold1 expression. See README for details
  */
@@ -73,6 +146,51 @@ expression::Window<N> window() {
   return expression::Window<N>();
 }
 
+/**
+ * Creates a window expression where the size and the
+ * hop are known at runtime. See README for details
+ */
+expression::DynamicWindow window(size_t size, size_t hop = 1);
+
+/**
+ * Creates an expression yielding the sum of each `window`
+ * consecutive elements. See README for details
+ */
+expression::RollingSum rolling_sum(size_t window);
+
+/**
+ * Creates an expression yielding the mean of each `window`
+ * consecutive elements. See README for details
+ */
+expression::RollingMean rolling_mean(size_t window);
+
+/**
+ * Creates an expression yielding the smallest of each `window`
+ * consecutive elements. See README for details
+ */
+expression::RollingMin rolling_min(size_t window);
+
+/**
+ * Creates an expression yielding the largest of each `window`
+ * consecutive elements. See README for details
+ */
+expression::RollingMax rolling_max(size_t window);
+
+/**
+ * Creates an expression counting the elements. See README for details
+ */
+expression::Count count();
+
+/**
+ * Creates an expression that sorts the elements. See README for details
+ */
+expression::Sorted sorted();
+
+/**
+ * Creates an expression marking the elements as sorted. See README for details
+ */
+expression::AssumeSorted assume_sorted();
+
 /**
  * Creates a take expression. See README for details
  */
@@ -96,6 +214,11 @@ expression::ForEach<F> for_each(F func) {
   return expression::ForEach<F>(func);
 }
 
+/**
+ * Creates a copied expression. See README for details.
+ */
+expression::Copied copied();
+
 /**
  * Creates a slice expression. See README for details.
  */
@@ -109,6 +232,38 @@ expression::ChunkMap<E> chunk_map(size_t size, expression::Expression<E> &&expr)
   return expression::ChunkMap<E>(size, std::move(expr));
 }
 
+/**
+ * Creates a parallel chunk map expression evaluated on `pool`
+ * with at most `max_in_flight` chunks processed at once.
+ * See README for details.
+ */
+template<typename E>
+expression::ParChunkMap<E> par_chunk_map(size_t size, expression::Expression<E> &&expr,
+                                         executor::ThreadPool &pool,
+                                         size_t max_in_flight) {
+  return expression::ParChunkMap<E>(size, std::move(expr), pool, max_in_flight);
+}
+
+/**
+ * Creates a parallel chunk map expression evaluated on `pool`
+ * with at most two chunks per worker processed at once.
+ * See README for details.
+ */
+template<typename E>
+expression::ParChunkMap<E> par_chunk_map(size_t size, expression::Expression<E> &&expr,
+                                         executor::ThreadPool &pool) {
+  return par_chunk_map(size, std::move(expr), pool, 2 * pool.thread_count());
+}
+
+/**
+ * Creates a parallel chunk map expression evaluated on the default pool.
+ * See README for details.
+ */
+template<typename E>
+expression::ParChunkMap<E> par_chunk_map(size_t size, expression::Expression<E> &&expr) {
+  return par_chunk_map(size, std::move(expr), executor::default_pool());
+}
+
 /**
  * Creates a chunk map expression. See README for details.
  */
@@ -127,6 +282,28 @@ expression::PartitionMap<E> partition_map(std::vector<size_t> partition_sizes, e
   return expression::PartitionMap<E>(std::move(partition_sizes), std::move(expr));
 }
 
+/**
+ * Creates a parallel partition map expression evaluated on `pool`.
+ * See README for details.
+ */
+template<typename E>
+expression::ParPartitionMap<E> par_partition_map(std::vector<size_t> partition_sizes,
+                                                 expression::Expression<E> &&expr,
+                                                 executor::ThreadPool &pool) {
+  return expression::ParPartitionMap<E>(std::move(partition_sizes), std::move(expr), pool);
+}
+
+/**
+ * Creates a parallel partition map expression evaluated on the default pool.
+ * See README for details.
+ */
+template<typename E>
+expression::ParPartitionMap<E> par_partition_map(std::vector<size_t> partition_sizes,
+                                                 expression::Expression<E> &&expr) {
+  return par_partition_map(std::move(partition_sizes), std::move(expr),
+                           executor::default_pool());
+}
+
 /**
  * Creates a prepend expression. See README for details.
  */
@@ -161,34 +338,38 @@ expression::Append<T> append(std::initializer_list<T> xs) {
 
 /**
  * Creates a composition of two expressions. `e1` is applied first, then `e2`.
+ * Adjacent maps, filters, takes and drops are fused into a single stage.
  */
 template<typename E1, typename E2>
-expression::Composition<E1, E2> operator|(const expression::Expression<E1> &e1, const expression::Expression<E2> &e2) {
-  return expression::Composition<E1, E2>(static_cast<const E1&>(e1), static_cast<const E2&>(e2));
+expression::Fused<E1, E2> operator|(const expression::Expression<E1> &e1, const expression::Expression<E2> &e2) {
+  return expression::Fusion<E1, E2>::fuse(static_cast<const E1&>(e1), static_cast<const E2&>(e2));
 }
 
 /**
  * Creates a composition of two expressions. `e1` is applied first, then `e2`.
+ * Adjacent maps, filters, takes and drops are fused into a single stage.
  */
 template<typename E1, typename E2>
-expression::Composition<E1, E2> operator|(expression::Expression<E1> &&e1, const expression::Expression<E2> &e2) {
-  return expression::Composition<E1, E2>(static_cast<E1&&>(e1), static_cast<const E2&>(e2));
+expression::Fused<E1, E2> operator|(expression::Expression<E1> &&e1, const expression::Expression<E2> &e2) {
+  return expression::Fusion<E1, E2>::fuse(static_cast<E1&&>(e1), static_cast<const E2&>(e2));
 }
 
 /**
  * Creates a composition of two expressions. `e1` is applied first, then `e2`.
+ * Adjacent maps, filters, takes and drops are fused into a single stage.
  */
 template<typename E1, typename E2>
-expression::Composition<E1, E2> operator|(const expression::Expression<E1> &e1, expression::Expression<E2> &&e2) {
-  return expression::Composition<E1, E2>(static_cast<const E1&>(e1), static_cast<E2&&>(e2));
+expression::Fused<E1, E2> operator|(const expression::Expression<E1> &e1, expression::Expression<E2> &&e2) {
+  return expression::Fusion<E1, E2>::fuse(static_cast<const E1&>(e1), static_cast<E2&&>(e2));
 }
 
 /**
  * Creates a composition of two expressions. `e1` is applied first, then `e2`.
+ * Adjacent maps, filters, takes and drops are fused into a single stage.
  */
 template<typename E1, typename E2>
-expression::Composition<E1, E2> operator|(expression::Expression<E1> &&e1, expression::Expression<E2> &&e2) {
-  return expression::Composition<E1, E2>(static_cast<E1&&>(e1), static_cast<E2&&>(e2));
+expression::Fused<E1, E2> operator|(expression::Expression<E1> &&e1, expression::Expression<E2> &&e2) {
+  return expression::Fusion<E1, E2>::fuse(static_cast<E1&&>(e1), static_cast<E2&&>(e2));
 }
 
 /**
@@ -224,11 +405,11 @@ iterator::STLPair<std::map, K, V> iter(const std::map<K, V> &collection) {
 }
 
 /**
- * Creates an iterator from an `std::map`. The map is moved.
+ * Creates an iterator from an `std::multimap`.
  */
 template<typename K, typename V>
-iterator::STLPairMove<std::map, K, V> iter(std::map<K, V> &&collection) {
-  return iterator::STLPairMove<std::map, K, V>(std::move(collection));
+iterator::STLPair<std::multimap, K, V> iter(const std::multimap<K, V> &collection) {
+  return iterator::STLPair<std::multimap, K, V>(collection);
 }
 
 /**
@@ -240,11 +421,129 @@ iterator::STLPair<std::unordered_map, K, V> iter(const std::unordered_map<K, V>
 }
 
 /**
- * Creates an iterator from an `std::unordered_map`. The map is moved.
+ * Creates an iterator from an `std::unordered_multimap`.
+ */
+template<typename K, typename V>
+iterator::STLPair<std::unordered_multimap, K, V> iter(const std::unordered_multimap<K, V> &collection) {
+  return iterator::STLPair<std::unordered_multimap, K, V>(collection);
+}
+
+/**
+ * Creates an iterator from an `std::map`. The map is moved,
+ * and each element is extracted so keys are moved instead of copied.
+ */
+template<typename K, typename V>
+iterator::NodeMove<std::map<K, V>> iter(std::map<K, V> &&collection) {
+  return iterator::NodeMove<std::map<K, V>>(std::move(collection));
+}
+
+/**
+ * Creates an iterator from an `std::multimap`. The map is moved,
+ * and each element is extracted so keys are moved instead of copied.
+ */
+template<typename K, typename V>
+iterator::NodeMove<std::multimap<K, V>> iter(std::multimap<K, V> &&collection) {
+  return iterator::NodeMove<std::multimap<K, V>>(std::move(collection));
+}
+
+/**
+ * Creates an iterator from an `std::unordered_map`. The map is moved,
+ * and each element is extracted so keys are moved instead of copied.
+ */
+template<typename K, typename V>
+iterator::NodeMove<std::unordered_map<K, V>> iter(std::unordered_map<K, V> &&collection) {
+  return iterator::NodeMove<std::unordered_map<K, V>>(std::move(collection));
+}
+
+/**
+ * Creates an iterator from an `std::unordered_multimap`. The map is moved,
+ * and each element is extracted so keys are moved instead of copied.
+ */
+template<typename K, typename V>
+iterator::NodeMove<std::unordered_multimap<K, V>> iter(std::unordered_multimap<K, V> &&collection) {
+  return iterator::NodeMove<std::unordered_multimap<K, V>>(std::move(collection));
+}
+
+/**
+ * Creates an iterator from an `std::set`. The set is moved,
+ * and each element is extracted so it is moved instead of copied.
+ */
+template<typename T>
+iterator::NodeMove<std::set<T>> iter(std::set<T> &&collection) {
+  return iterator::NodeMove<std::set<T>>(std::move(collection));
+}
+
+/**
+ * Creates an iterator from an `std::multiset`. The set is moved,
+ * and each element is extracted so it is moved instead of copied.
+ */
+template<typename T>
+iterator::NodeMove<std::multiset<T>> iter(std::multiset<T> &&collection) {
+  return iterator::NodeMove<std::multiset<T>>(std::move(collection));
+}
+
+/**
+ * Creates an iterator from an `std::unordered_set`. The set is moved,
+ * and each element is extracted so it is moved instead of copied.
+ */
+template<typename T>
+iterator::NodeMove<std::unordered_set<T>> iter(std::unordered_set<T> &&collection) {
+  return iterator::NodeMove<std::unordered_set<T>>(std::move(collection));
+}
+
+/**
+ * Creates an iterator from an `std::unordered_multiset`. The set is moved,
+ * and each element is extracted so it is moved instead of copied.
+ */
+template<typename T>
+iterator::NodeMove<std::unordered_multiset<T>> iter(std::unordered_multiset<T> &&collection) {
+  return iterator::NodeMove<std::unordered_multiset<T>>(std::move(collection));
+}
+
+/**
+ * Creates an iterator over a `flat_set`. The elements are
+ * contiguous and sorted.
+ */
+template<typename T>
+iterator::Sorted<iterator::Pointer<T>> iter(const container::flat_set<T> &collection) {
+  return iterator::Sorted(iterator::Pointer<T>(collection.data(), collection.size()));
+}
+
+/**
+ * Creates an iterator over a `flat_set`. The set is moved
+ */
+template<typename T>
+iterator::Sorted<iterator::STLMove<std::vector, T>> iter(container::flat_set<T> &&collection) {
+  return iterator::Sorted(iterator::STLMove<std::vector, T>(std::move(collection).extract()));
+}
+
+/**
+ * Creates an iterator over a `flat_map`. The items are
+ * contiguous and sorted by key.
  */
 template<typename K, typename V>
-iterator::STLPairMove<std::unordered_map, K, V> iter(std::unordered_map<K, V> &&collection) {
-  return iterator::STLPairMove<std::unordered_map, K, V>(std::move(collection));
+iterator::Sorted<iterator::Pointer<std::pair<K, V>>> iter(const container::flat_map<K, V> &collection) {
+  return iterator::Sorted(
+          iterator::Pointer<std::pair<K, V>>(collection.data(), collection.size()));
+}
+
+/**
+ * Creates an iterator over a `flat_map`. The map is moved
+ */
+template<typename K, typename V>
+iterator::Sorted<iterator::STLMove<std::vector, std::pair<K, V>>> iter(container::flat_map<K, V> &&collection) {
+  return iterator::Sorted(
+          iterator::STLMove<std::vector, std::pair<K, V>>(std::move(collection).extract()));
+}
+
+/**
+ * Creates an iterator over the node handles of a set or map. The
+ * container is moved. See README for details.
+ */
+template<typename C>
+iterator::Nodes<C> iter_nodes(C &&collection) {
+  static_assert(!std::is_reference_v<C>, "iter_nodes takes ownership of the container");
+  return iterator::Nodes<C>(std::move(collection));
 }
 
 /**
@@ -263,12 +562,46 @@ iterator::ArrayMove<T, N> iter(std::array<T, N> &&collection) {
   return iterator::ArrayMove<T, N>(std::move(collection));
 }
 
+/**
+ * Creates an iterator over at most `N` items stored inline, without
+ * allocating. Throws `std::length_error` if there are more than `N` items
+ */
+template<size_t N, typename T>
+iterator::Inline<T, N> iter_inline(std::initializer_list<T> xs) {
+  return iterator::Inline<T, N>(xs);
+}
+
+/**
+ * Creates an iterator over a single item, without allocating
+ */
+template<typename T>
+iterator::Inline<T, 1> once(T x) {
+  iterator::Inline<T, 1> result;
+  result.push_back(std::move(x));
+
+  return result;
+}
+
+/**
+ * Creates an iterator over two items, without allocating
+ */
+template<typename T>
+iterator::Inline<T, 2> pair_of(T first, T second) {
+  iterator::Inline<T, 2> result;
+  result.push_back(std::move(first));
+  result.push_back(std::move(second));
+
+  return result;
+}
+
 /**
  * Creates an iterator from an initializer list.
+ * The items are copied to memory from the current resource.
  */
 template<typename T>
-iterator::STLMove<std::vector, T> iter(std::initializer_list<T>&& xs) {
-  return iterator::STLMove<std::vector, T>(std::move(xs));
+iterator::STLMove<std::pmr::vector, T> iter(std::initializer_list<T>&& xs) {
+  return iterator::STLMove<std::pmr::vector, T>(
+          std::pmr::vector<T>(xs, iterator::current_resource()));
 }
 
 template<typename T>
@@ -281,6 +614,32 @@ iterator::PointerMove<T> iter(T*&& underlying, size_t element_count) {
   return iterator::PointerMove<T>(std::move(underlying), element_count);
 }
 
+/**
+ * Creates an iterator that yields references to the elements
+ * of a collection instead of copies. See README for details.
+ */
+template<typename C>
+iterator::Ref<typename C::const_iterator> iter_ref(const C &collection) {
+  return iterator::Ref<typename C::const_iterator>(
+          collection.begin(), collection.end(), collection.size());
+}
+
+/**
+ * Borrowing a temporary would leave dangling references
+ */
+template<typename C>
+void iter_ref(const C &&collection) = delete;
+
+/**
+ * Creates an iterator that yields references to `element_count`
+ * elements starting at `underlying`.
+ */
+template<typename T>
+iterator::Ref<const T *> iter_ref(const T *underlying, size_t element_count) {
+  return iterator::Ref<const T *>(underlying, underlying + element_count,
+                                  element_count);
+}
+
 /**
  * Creates a zip iterator from two iterators. See README for details
  */
@@ -299,6 +658,7 @@ iterator::Concat<I1, I2> concat(iterator::Iterator<I1> &&left, iterator::Iterato
 
 /**
  * Creates an iterator over the range `[begin, end)` with step size `step`.
+ * Integer ranges whose step isn't positive never reach `end` and are endless.
  */
 template<typename T>
 iterator::Range<T> range(T begin, T end, T step) {
@@ -346,9 +706,18 @@ struct collect<std::vector> {};
 template<typename I>
 std::vector<iterator::OutputType<I>> operator|(iterator::Iterator<I> &&iter, collect<std::vector> &&) {
   std::vector<iterator::OutputType<I>> result;
-
-  for (auto content = iter.next(); content.has_value(); content = iter.next()) {
-    result.push_back(std::move(content.value()));
+  result.reserve(iter.size_hint().lower);
+
+  if constexpr (iterator::is_batched_v<I>
+                && iterator::is_batchable_v<iterator::OutputType<I>>) {
+    iterator::for_each_batch(iter, [&](auto *items, size_t count) {
+      result.insert(result.end(), items, items + count);
+    });
+  } else {
+    iter.for_each_while([&](auto &&content) {
+      result.push_back(std::forward<decltype(content)>(content));
+      return true;
+    });
   }
 
   return std::move(result);
@@ -358,15 +727,21 @@ template<>
 struct collect<std::set> {};
 
 /**
- * Collects an iterator into an `std::set`.
+ * Collects an iterator into an `std::set`. Sorted
+ * iterators are appended at the end in linear time.
  */
 template<typename I>
-std::set<iterator::OutputType<I>> operator|(iterator::Iterator<I> &&iter, collect<std::set> &&) {
-  std::set<iterator::OutputType<I>> result;
-
-  for (auto content = iter.next(); content.has_value(); content = iter.next()) {
-    result.insert(std::move(content.value()));
-  }
+std::set<iterator::SetElementType<I>> operator|(iterator::Iterator<I> &&iter, collect<std::set> &&) {
+  std::set<iterator::SetElementType<I>> result;
+
+  iter.for_each_while([&](auto &&content) {
+    if constexpr (iterator::is_sorted_v<I>) {
+      iterator::insert_element(result, result.end(), std::forward<decltype(content)>(content));
+    } else {
+      iterator::insert_element(result, std::forward<decltype(content)>(content));
+    }
+    return true;
+  });
 
   return std::move(result);
 }
@@ -378,12 +753,14 @@ struct collect<std::unordered_set> {};
  * Collects an iterator into an `std::unordered_set`.
  */
 template<typename I>
-std::unordered_set<iterator::OutputType<I>> operator|(iterator::Iterator<I> &&iter, collect<std::unordered_set> &&) {
-  std::unordered_set<iterator::OutputType<I>> result;
+std::unordered_set<iterator::SetElementType<I>> operator|(iterator::Iterator<I> &&iter, collect<std::unordered_set> &&) {
+  std::unordered_set<iterator::SetElementType<I>> result;
+  result.reserve(iter.size_hint().lower);
 
-  for (auto content = iter.next(); content.has_value(); content = iter.next()) {
-    result.insert(std::move(content.value()));
-  }
+  iter.for_each_while([&](auto &&content) {
+    iterator::insert_element(result, std::forward<decltype(content)>(content));
+    return true;
+  });
 
   return std::move(result);
 }
@@ -392,16 +769,22 @@ template<>
 struct collect<std::map> {};
 
 /**
- * Collects an iterator into an `std::map`.
+ * Collects an iterator into an `std::map`. Sorted
+ * iterators are appended at the end in linear time.
  */
 template<typename I>
-std::map<typename iterator::OutputType<I>::first_type, typename iterator::OutputType<I>::second_type>
+std::map<iterator::MapKeyType<I>, iterator::MapValueType<I>>
         operator|(iterator::Iterator<I> &&iter, collect<std::map> &&) {
-  std::map<typename iterator::OutputType<I>::first_type, typename iterator::OutputType<I>::second_type> result;
+  std::map<iterator::MapKeyType<I>, iterator::MapValueType<I>> result;
 
-  for (auto content = iter.next(); content.has_value(); content = iter.next()) {
-    result.insert(std::move(content.value()));
-  }
+  iter.for_each_while([&](auto &&content) {
+    if constexpr (iterator::is_sorted_v<I>) {
+      iterator::insert_element(result, result.end(), std::forward<decltype(content)>(content));
+    } else {
+      iterator::insert_element(result, std::forward<decltype(content)>(content));
+    }
+    return true;
+  });
 
   return std::move(result);
 }
@@ -413,15 +796,203 @@ struct collect<std::unordered_map> {};
  * Collects an iterator into an `std::unordered_map`.
  */
 template<typename I>
-std::unordered_map<typename iterator::OutputType<I>::first_type, typename iterator::OutputType<I>::second_type>
+std::unordered_map<iterator::MapKeyType<I>, iterator::MapValueType<I>>
 operator|(iterator::Iterator<I> &&iter, collect<std::unordered_map> &&) {
-  std::unordered_map<typename iterator::OutputType<I>::first_type, typename iterator::OutputType<I>::second_type> result;
+  std::unordered_map<iterator::MapKeyType<I>, iterator::MapValueType<I>> result;
+  result.reserve(iter.size_hint().lower);
 
-  for (auto content = iter.next(); content.has_value(); content = iter.next()) {
-    result.insert(std::move(content.value()));
-  }
+  iter.for_each_while([&](auto &&content) {
+    iterator::insert_element(result, std::forward<decltype(content)>(content));
+    return true;
+  });
 
   return std::move(result);
 }
 
+/**
+ * Collects an iterator into an empty `C`, which may be any container
+ * with `emplace_back` or `insert`, e.g. one with a custom hash, comparator
+ * or allocator. `std::pmr` containers allocate from the current resource.
+ * See README for details
+ */
+template<typename C>
+struct collect_as {};
+
+template<typename I, typename C>
+C operator|(iterator::Iterator<I> &&iter, collect_as<C> &&) {
+  C result = iterator::make_container<C>();
+  iterator::append_all(result, static_cast<I &>(iter));
+
+  return result;
+}
+
+/**
+ * Appends the elements of an iterator to an existing container.
+ * See README for details
+ */
+template<typename C>
+struct collect_into {
+  explicit collect_into(C &container) : container(&container) {}
+
+  C *container;
+};
+
+template<typename I, typename C>
+C &operator|(iterator::Iterator<I> &&iter, collect_into<C> &&into) {
+  iterator::append_all(*into.container, static_cast<I &>(iter));
+
+  return *into.container;
+}
+
+/**
+ * How `write_to` stores elements
+ */
+enum class Store {
+  /** Ordinary stores through the caches */
+  Normal,
+  /** Non-temporal stores that bypass the caches, for large outputs */
+  NonTemporal,
+};
+
+/**
+ * Writes the elements of an iterator to `out`, which has room for
+ * `capacity` elements, and returns how many were written. Elements past
+ * the capacity are dropped. `out` is raw memory: the elements are
+ * constructed in place, and the caller must destroy them unless `T`
+ * is trivially destructible. See README for details
+ */
+template<typename T>
+struct write_to {
+  explicit write_to(T *out, size_t capacity, Store store = Store::Normal)
+          : out(out), capacity(capacity), store(store) {}
+
+  T *out;
+  size_t capacity;
+  Store store;
+};
+
+template<typename I, typename T>
+size_t operator|(iterator::Iterator<I> &&iter, write_to<T> &&into) {
+  using U = iterator::OutputType<I>;
+
+  if constexpr (std::is_same_v<U, T> && std::is_trivially_copyable_v<T>) {
+    if (into.store == Store::NonTemporal) {
+      auto &source = static_cast<I &>(iter);
+
+      if constexpr (iterator::is_contiguous_v<I>) {
+        size_t n = std::min(into.capacity, source.size_hint().lower);
+        if (n > 0) {
+          kernel::stream_copy(into.out, source.data(), n * sizeof(T));
+          source.advance(n);
+        }
+
+        return n;
+      } else if constexpr (iterator::is_batchable_v<T>) {
+        std::array<T, iterator::batch_size> buffer;
+        size_t written = 0;
+
+        for (;;) {
+          size_t wanted = std::min(buffer.size(), into.capacity - written);
+          if (wanted == 0) { break; }
+
+          size_t n = iter.next_batch(buffer.data(), wanted);
+          kernel::stream_copy(into.out + written, buffer.data(), n * sizeof(T));
+          written += n;
+
+          if (n < wanted) { break; }
+        }
+
+        return written;
+      }
+    }
+  }
+
+  if constexpr (std::is_same_v<U, T> && std::is_trivially_copyable_v<T>) {
+    return iter.next_batch(into.out, into.capacity);
+  } else {
+    size_t written = 0;
+    if (into.capacity == 0) { return 0; }
+
+    try {
+      iter.for_each_while([&](auto &&content) {
+        ::new(static_cast<void *>(into.out + written)) T(std::forward<decltype(content)>(content));
+        ++written;
+
+        return written < into.capacity;
+      });
+    } catch (...) {
+      std::destroy_n(into.out, written);
+      throw;
+    }
+
+    return written;
+  }
+}
+
+template<>
+struct collect<container::flat_set> {};
+
+/**
+ * Collects an iterator into a `flat_set`. The elements are gathered
+ * in a vector, then sorted unless the iterator is sorted already,
+ * and deduplicated.
+ */
+template<typename I>
+container::flat_set<iterator::OutputType<I>> operator|(iterator::Iterator<I> &&iter, collect<container::flat_set> &&) {
+  auto items = static_cast<I &&>(iter) | collect<std::vector>();
+
+  if constexpr (iterator::is_sorted_v<I>) {
+    return container::flat_set<iterator::OutputType<I>>::from_sorted(std::move(items));
+  } else {
+    return container::flat_set<iterator::OutputType<I>>(std::move(items));
+  }
+}
+
+template<>
+struct collect<container::flat_map> {};
+
+/**
+ * Collects an iterator into a `flat_map`. The items are gathered
+ * in a vector, then sorted by key unless the iterator is sorted
+ * already, and the first item of each key is kept.
+ */
+template<typename I>
+container::flat_map<iterator::MapKeyType<I>, iterator::MapValueType<I>>
+operator|(iterator::Iterator<I> &&iter, collect<container::flat_map> &&) {
+  using Map = container::flat_map<iterator::MapKeyType<I>, iterator::MapValueType<I>>;
+
+  std::vector<typename Map::value_type> items;
+  items.reserve(iter.size_hint().lower);
+
+  iter.for_each_while([&](auto &&content) {
+    items.emplace_back(std::forward<decltype(content)>(content));
+    return true;
+  });
+
+  if constexpr (iterator::is_sorted_v<I>) {
+    return Map::from_sorted(std::move(items));
+  } else {
+    return Map(std::move(items));
+  }
+}
+
+/**
+ * Calls `func` with `resource` as the current resource of this thread,
+ * so stages and `std::pmr` collections built by `func` allocate from it.
+ * See README for details
+ */
+template<typename F>
+decltype(auto) with_resource(std::pmr::memory_resource *resource, F &&func) {
+  iterator::ResourceScope scope(resource);
+
+  return std::forward<F>(func)();
+}
+
+/**
+ * The memory resource that pipeline stages allocate from on this thread
+ */
+inline std::pmr::memory_resource *current_resource() {
+  return iterator::current_resource();
+}
+
 }// namespace colex
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "../src/flat_map.hpp"
+#include "../src/flat_set.hpp"
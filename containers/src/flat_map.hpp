@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace colex::container {
+
+/**
+ * A map stored as a vector of pairs sorted by key without duplicate
+ * keys. Lookups are binary searches over contiguous memory, and there
+ * is no per-element node overhead. Inserting is linear, so it suits
+ * data that is built once and then mostly read.
+ */
+template<typename K, typename V>
+class flat_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+  using iterator = typename std::vector<value_type>::iterator;
+
+  flat_map() = default;
+
+  /**
+   * Sorts `items` by key. Of several items with the same key,
+   * the first one is kept, like inserting them into an `std::map`.
+   */
+  explicit flat_map(std::vector<value_type> items) : m_items(std::move(items)) {
+    std::stable_sort(m_items.begin(), m_items.end(), KeyLess());
+    deduplicate();
+  }
+
+  /**
+   * Takes `items`, which must be sorted by key, and keeps
+   * the first of several items with the same key.
+   * The order is only checked in debug builds.
+   */
+  static flat_map from_sorted(std::vector<value_type> items) {
+    assert(std::is_sorted(items.begin(), items.end(), KeyLess()));
+
+    flat_map result;
+    result.m_items = std::move(items);
+    result.deduplicate();
+
+    return result;
+  }
+
+  [[nodiscard]] const_iterator begin() const { return m_items.begin(); }
+  [[nodiscard]] const_iterator end() const { return m_items.end(); }
+  [[nodiscard]] const value_type *data() const { return m_items.data(); }
+  [[nodiscard]] size_t size() const { return m_items.size(); }
+  [[nodiscard]] bool empty() const { return m_items.empty(); }
+
+  [[nodiscard]] const_iterator lower_bound(const K &key) const {
+    return std::lower_bound(m_items.begin(), m_items.end(), key, KeyLess());
+  }
+
+  [[nodiscard]] const_iterator upper_bound(const K &key) const {
+    return std::upper_bound(m_items.begin(), m_items.end(), key, KeyLess());
+  }
+
+  /**
+   * Returns the item with key `key`, or `end()` if there is none
+   */
+  [[nodiscard]] const_iterator find(const K &key) const {
+    auto it = lower_bound(key);
+    return it != m_items.end() && !(key < it->first) ? it : m_items.end();
+  }
+
+  [[nodiscard]] bool contains(const K &key) const { return find(key) != m_items.end(); }
+
+  [[nodiscard]] size_t count(const K &key) const { return contains(key); }
+
+  /**
+   * Returns the value with key `key`. Throws `std::out_of_range` if there is none.
+   */
+  [[nodiscard]] const V &at(const K &key) const {
+    auto it = find(key);
+    if (it == m_items.end()) { throw std::out_of_range("flat_map::at"); }
+
+    return it->second;
+  }
+
+  [[nodiscard]] V &at(const K &key) {
+    return const_cast<V &>(static_cast<const flat_map &>(*this).at(key));
+  }
+
+  /**
+   * Inserts `item` unless its key is already present. Takes linear time.
+   */
+  std::pair<const_iterator, bool> insert(value_type item) {
+    auto it = lower_bound(item.first);
+    if (it != m_items.end() && !(item.first < it->first)) { return {it, false}; }
+
+    return {m_items.insert(it, std::move(item)), true};
+  }
+
+  /**
+   * Releases the items sorted by key
+   */
+  std::vector<value_type> extract() && { return std::move(m_items); }
+
+  friend bool operator==(const flat_map &a, const flat_map &b) {
+    return a.m_items == b.m_items;
+  }
+
+  friend bool operator!=(const flat_map &a, const flat_map &b) { return !(a == b); }
+
+ private:
+  struct KeyLess {
+    bool operator()(const value_type &a, const value_type &b) const { return a.first < b.first; }
+    bool operator()(const value_type &a, const K &b) const { return a.first < b; }
+    bool operator()(const K &a, const value_type &b) const { return a < b.first; }
+  };
+
+  void deduplicate() {
+    m_items.erase(std::unique(m_items.begin(), m_items.end(),
+                              [](const value_type &a, const value_type &b) {
+                                return !(a.first < b.first);
+                              }),
+                  m_items.end());
+  }
+
+  std::vector<value_type> m_items;
+};
+
+}
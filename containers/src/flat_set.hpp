@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace colex::container {
+
+/**
+ * A set stored as a sorted vector without duplicates. Lookups are
+ * binary searches over contiguous memory, and there is no per-element
+ * node overhead. Inserting is linear, so it suits data that is built
+ * once and then mostly read.
+ */
+template<typename T>
+class flat_set {
+ public:
+  using value_type = T;
+  using const_iterator = typename std::vector<T>::const_iterator;
+  using iterator = const_iterator;
+
+  flat_set() = default;
+
+  /**
+   * Sorts `items` and removes duplicates
+   */
+  explicit flat_set(std::vector<T> items) : m_items(std::move(items)) {
+    std::sort(m_items.begin(), m_items.end());
+    deduplicate();
+  }
+
+  /**
+   * Takes `items`, which must be sorted, and removes duplicates.
+   * The order is only checked in debug builds.
+   */
+  static flat_set from_sorted(std::vector<T> items) {
+    assert(std::is_sorted(items.begin(), items.end()));
+
+    flat_set result;
+    result.m_items = std::move(items);
+    result.deduplicate();
+
+    return result;
+  }
+
+  [[nodiscard]] const_iterator begin() const { return m_items.begin(); }
+  [[nodiscard]] const_iterator end() const { return m_items.end(); }
+  [[nodiscard]] const T *data() const { return m_items.data(); }
+  [[nodiscard]] size_t size() const { return m_items.size(); }
+  [[nodiscard]] bool empty() const { return m_items.empty(); }
+
+  [[nodiscard]] const_iterator lower_bound(const T &value) const {
+    return std::lower_bound(m_items.begin(), m_items.end(), value);
+  }
+
+  [[nodiscard]] const_iterator upper_bound(const T &value) const {
+    return std::upper_bound(m_items.begin(), m_items.end(), value);
+  }
+
+  /**
+   * Returns the element equal to `value`, or `end()` if there is none
+   */
+  [[nodiscard]] const_iterator find(const T &value) const {
+    auto it = lower_bound(value);
+    return it != m_items.end() && !(value < *it) ? it : m_items.end();
+  }
+
+  [[nodiscard]] bool contains(const T &value) const {
+    return find(value) != m_items.end();
+  }
+
+  [[nodiscard]] size_t count(const T &value) const { return contains(value); }
+
+  /**
+   * Inserts `value` unless it is already present. Takes linear time.
+   */
+  std::pair<const_iterator, bool> insert(T value) {
+    auto it = lower_bound(value);
+    if (it != m_items.end() && !(value < *it)) { return {it, false}; }
+
+    return {m_items.insert(it, std::move(value)), true};
+  }
+
+  /**
+   * Releases the sorted elements
+   */
+  std::vector<T> extract() && { return std::move(m_items); }
+
+  friend bool operator==(const flat_set &a, const flat_set &b) {
+    return a.m_items == b.m_items;
+  }
+
+  friend bool operator!=(const flat_set &a, const flat_set &b) { return !(a == b); }
+
+ private:
+  void deduplicate() {
+    m_items.erase(std::unique(m_items.begin(), m_items.end(),
+                              [](const T &a, const T &b) { return !(a < b); }),
+                  m_items.end());
+  }
+
+  std::vector<T> m_items;
+};
+
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../src/thread_pool.hpp"
@@ -0,0 +1,130 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace colex::executor {
+
+namespace {
+
+/**
+ * The pool the current thread works for, if any
+ */
+thread_local const ThreadPool *current_pool = nullptr;
+
+/**
+ * The index of the current thread's queue in `current_pool`
+ */
+thread_local size_t current_index = 0;
+
+}
+
+ThreadPool::ThreadPool(size_t thread_count)
+        : m_pending(0), m_next_queue(0), m_stopping(false) {
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    m_queues.push_back(std::make_unique<Queue>());
+  }
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    m_threads.emplace_back([this, i]() { work(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+
+  for (auto &thread : m_threads) { thread.join(); }
+}
+
+void ThreadPool::push(Task task) {
+  size_t index = current_pool == this
+                 ? current_index
+                 : m_next_queue.fetch_add(1) % m_queues.size();
+
+  m_pending.fetch_add(1);
+
+  {
+    std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+    m_queues[index]->tasks.push_back(std::move(task));
+  }
+
+  // Taking the lock orders the increment before a sleeping
+  // worker's check, so the notification can't be lost.
+  { std::lock_guard<std::mutex> lock(m_sleep_mutex); }
+  m_wake.notify_one();
+}
+
+bool ThreadPool::try_pop(size_t index, Task &task) {
+  std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+  auto &tasks = m_queues[index]->tasks;
+
+  if (tasks.empty()) { return false; }
+
+  task = std::move(tasks.back());
+  tasks.pop_back();
+  m_pending.fetch_sub(1);
+  return true;
+}
+
+bool ThreadPool::try_steal(size_t thief, Task &task) {
+  for (size_t offset = 1; offset <= m_queues.size(); ++offset) {
+    size_t index = (thief + offset) % m_queues.size();
+    std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+    auto &tasks = m_queues[index]->tasks;
+
+    if (!tasks.empty()) {
+      task = std::move(tasks.front());
+      tasks.pop_front();
+      m_pending.fetch_sub(1);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool ThreadPool::try_run_one() {
+  Task task;
+  size_t index = current_pool == this ? current_index : 0;
+
+  if ((current_pool == this && try_pop(index, task))
+      || try_steal(index, task)) {
+    task();
+    return true;
+  }
+
+  return false;
+}
+
+void ThreadPool::work(size_t index) {
+  current_pool = this;
+  current_index = index;
+
+  for (;;) {
+    Task task;
+
+    if (try_pop(index, task) || try_steal(index, task)) {
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_sleep_mutex);
+    m_wake.wait(lock, [this]() { return m_stopping || m_pending.load() > 0; });
+
+    if (m_stopping && m_pending.load() == 0) { return; }
+  }
+}
+
+ThreadPool &default_pool() {
+  static ThreadPool pool;
+  return pool;
+}
+
+}
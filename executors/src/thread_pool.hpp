@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace colex::executor {
+
+/**
+ * A fixed set of worker threads that run submitted tasks.
+ * Every worker owns a deque of tasks. Workers take work from the back
+ * of their own deque, and steal from the front of the others' deques
+ * when their own runs dry. Tasks submitted from a worker go to that
+ * worker's deque, other tasks are spread over all deques.
+ */
+class ThreadPool {
+ public:
+  /**
+   * Starts `thread_count` workers. Zero means one per hardware thread.
+   */
+  explicit ThreadPool(size_t thread_count = 0);
+
+  /**
+   * Finishes all queued tasks and joins the workers
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ThreadPool &operator=(ThreadPool &&) = delete;
+
+  /**
+   * The number of worker threads
+   */
+  [[nodiscard]] size_t thread_count() const { return m_threads.size(); }
+
+  /**
+   * Schedules `func` to run on a worker. The returned future
+   * holds its result, or the exception it threw.
+   */
+  template<typename F>
+  std::future<std::invoke_result_t<F>> submit(F func) {
+    using R = std::invoke_result_t<F>;
+
+    auto task = std::make_shared<std::packaged_task<R()>>(std::move(func));
+    auto future = task->get_future();
+    push([task]() { (*task)(); });
+
+    return future;
+  }
+
+  /**
+   * Blocks until `future` is ready. Queued tasks are run on the
+   * calling thread in the meantime, so waiting from inside a task
+   * can't starve the pool.
+   */
+  template<typename T>
+  void wait(const std::future<T> &future) {
+    while (future.wait_for(std::chrono::seconds(0))
+           != std::future_status::ready) {
+      if (!try_run_one()) { future.wait_for(std::chrono::microseconds(50)); }
+    }
+  }
+
+ private:
+  using Task = std::function<void()>;
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void push(Task task);
+  bool try_pop(size_t index, Task &task);
+  bool try_steal(size_t thief, Task &task);
+  bool try_run_one();
+  void work(size_t index);
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<std::thread> m_threads;
+  std::atomic<size_t> m_pending;
+  std::atomic<size_t> m_next_queue;
+  std::mutex m_sleep_mutex;
+  std::condition_variable m_wake;
+  bool m_stopping;
+};
+
+/**
+ * A process wide pool with one worker per hardware thread,
+ * started the first time it is used.
+ */
+ThreadPool &default_pool();
+
+}
@@ -5,18 +5,29 @@
 #include "../src/append.hpp"
 #include "../src/chunk.hpp"
 #include "../src/chunk_map.hpp"
+#include "../src/count.hpp"
 #include "../src/composition.hpp"
+#include "../src/copied.hpp"
 #include "../src/drop.hpp"
 #include "../src/enumerate.hpp"
 #include "../src/filter.hpp"
 #include "../src/flat_map.hpp"
 #include "../src/flatten.hpp"
 #include "../src/fold.hpp"
+#include "../src/fusion.hpp"
 #include "../src/for_each.hpp"
 #include "../src/map.hpp"
+#include "../src/map_filter.hpp"
+#include "../src/par_chunk_map.hpp"
+#include "../src/par_map.hpp"
+#include "../src/par_partition_map.hpp"
+#include "../src/par_reduce.hpp"
 #include "../src/partition.hpp"
 #include "../src/partition_map.hpp"
 #include "../src/prepend.hpp"
+#include "../src/reductions.hpp"
+#include "../src/rolling.hpp"
 #include "../src/scan.hpp"
+#include "../src/sorted.hpp"
 #include "../src/take.hpp"
 #include "../src/window.hpp"
\ No newline at end of file
@@ -4,27 +4,36 @@
 
 #include "iterators/inc/iterators.hpp"
 
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
 #include <vector>
 
 namespace colex::expression {
 
+/**
+ * The items are kept in memory from the current resource
+ */
 template<typename T>
 class Append : public Expression<Append<T>> {
  public:
-  Append(std::vector<T> xs) : m_xs(std::move(xs)) {}
+  Append(std::vector<T> xs)
+          : m_xs(std::make_move_iterator(xs.begin()), std::make_move_iterator(xs.end()),
+                 iterator::current_resource()) {}
+  Append(std::initializer_list<T> xs) : m_xs(xs, iterator::current_resource()) {}
 
   template<typename I>
   OutputType<Append<T>, I> apply(iterator::Iterator<I> &&iter) const {
-    return iterator::Concat(std::move(iter), iterator::STL(m_xs));
+    return iterator::Concat(std::move(iter), iterator::STL<std::pmr::vector, T>(m_xs));
   }
 
  private:
-  std::vector<T> m_xs;
+  std::pmr::vector<T> m_xs;
 };
 
 template<typename T, typename I>
 struct Types<Append<T>, I> {
-  using Output = iterator::Concat<iterator::STL<std::vector, T>, I>;
+  using Output = iterator::Concat<I, iterator::STL<std::pmr::vector, T>>;
 };
 
 }
@@ -2,6 +2,8 @@
 
 #include "../inc/interface.hpp"
 
+#include <type_traits>
+
 namespace colex::expression {
 
 template<typename E1, typename E2>
@@ -18,6 +20,10 @@ class Composition : public Expression<Composition<E1, E2>> {
     return e2.apply(e1.apply(std::move(iter)));
   }
 
+  [[nodiscard]] const E1 &first() const { return e1; }
+
+  [[nodiscard]] const E2 &second() const { return e2; }
+
  private:
   E1 e1;
   E2 e2;
@@ -28,4 +34,38 @@ struct Types<Composition<E1, E2>, I> {
   using Output = OutputType<E2, OutputType<E1, I>>;
 };
 
+/**
+ * Decides how two adjacent expressions are combined when `e1 | e2`
+ * is written. By default they are nested in a `Composition`.
+ * Specializations with `fuses = true` merge the two into a single
+ * stage instead, which saves an iterator layer per element.
+ */
+template<typename E1, typename E2, typename = void>
+struct Fusion {
+  static constexpr bool fuses = false;
+
+  static Composition<E1, E2> fuse(E1 e1, E2 e2) {
+    return Composition<E1, E2>(std::move(e1), std::move(e2));
+  }
+};
+
+/**
+ * `(e1 | e2) | e3` fuses `e2` and `e3` if possible
+ */
+template<typename E1, typename E2, typename E3>
+struct Fusion<Composition<E1, E2>, E3, std::enable_if_t<Fusion<E2, E3>::fuses>> {
+  static constexpr bool fuses = true;
+
+  static auto fuse(Composition<E1, E2> e12, E3 e3) {
+    auto tail = Fusion<E2, E3>::fuse(e12.second(), std::move(e3));
+    return Composition<E1, decltype(tail)>(e12.first(), std::move(tail));
+  }
+};
+
+/**
+ * The expression `e1 | e2` results in
+ */
+template<typename E1, typename E2>
+using Fused = decltype(Fusion<E1, E2>::fuse(std::declval<E1>(), std::declval<E2>()));
+
 }
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+namespace colex::expression {
+
+class Copied : public Expression<Copied> {
+ public:
+  template<typename I>
+  OutputType<Copied, I> apply(iterator::Iterator<I> &&iter) const {
+    return iterator::Copied<I>(std::move(iter));
+  }
+};
+
+template<typename I>
+struct Types<Copied, I> {
+  using Output = iterator::Copied<I>;
+};
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+namespace colex::expression {
+
+class Count : public Expression<Count> {
+ public:
+  /**
+   * Random access iterators of known length are not stepped through
+   */
+  template<typename I>
+  OutputType<Count, I> apply(iterator::Iterator<I> &&iter) const {
+    if constexpr (iterator::is_random_access_v<I>) {
+      auto hint = iter.size_hint();
+
+      if (hint.upper.has_value()) {
+        static_cast<I &>(iter).advance(hint.lower);
+        return hint.lower;
+      }
+    }
+
+    size_t count = 0;
+
+    iter.for_each_while([&](auto &&) {
+      ++count;
+      return true;
+    });
+
+    return count;
+  }
+};
+
+template<typename I>
+struct Types<Count, I> {
+  using Output = size_t;
+};
+
+}
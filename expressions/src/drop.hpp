@@ -2,24 +2,38 @@
 
 #include "../inc/interface.hpp"
 
+#include <type_traits>
+
 namespace colex::expression {
 
 class Drop : public Expression<Drop> {
  public:
-  explicit Drop(size_t count) : count(count) {}
+  explicit Drop(size_t count) : m_count(count) {}
 
   template<typename I>
   OutputType<Drop, I> apply(iterator::Iterator<I> &&iter) const {
-    return iterator::Drop<I>(count, std::move(iter));
+    if constexpr (iterator::is_random_access_v<I>) {
+      I result = static_cast<I &&>(iter);
+      result.advance(m_count);
+      return result;
+    } else {
+      return iterator::Drop<I>(m_count, std::move(iter));
+    }
   }
 
+  [[nodiscard]] size_t count() const { return m_count; }
+
  private:
-  size_t count;
+  size_t m_count;
 };
 
+/**
+ * Random access iterators are advanced in place instead of wrapped
+ */
 template<typename I>
 struct Types<Drop, I> {
-  using Output = iterator::Drop<I>;
+  using Output = std::conditional_t<iterator::is_random_access_v<I>, I,
+                                    iterator::Drop<I>>;
 };
 
 }
@@ -14,6 +14,8 @@ class Filter : public Expression<Filter<F>> {
     return iterator::Filter<F, I>(predicate, std::move(iter));
   }
 
+  [[nodiscard]] const F &function() const { return predicate; }
+
  private:
   F predicate;
 };
@@ -1,9 +1,44 @@
 #pragma once
 
 #include "../inc/interface.hpp"
+#include "reductions.hpp"
+
+#include <functional>
 
 namespace colex::expression {
 
+/**
+ * Computes a fold with `F` over a block of `T`s using the reduction
+ * kernels. Only exists for integers, since reordering floating point
+ * sums and products changes their result, and the min and max kernels
+ * treat NaN differently than `Minimum` and `Maximum` do.
+ */
+template<typename F, typename T>
+struct FoldKernel {
+  static constexpr bool is_sum =
+          std::is_same_v<F, std::plus<T>> || std::is_same_v<F, std::plus<>>;
+  static constexpr bool is_product =
+          std::is_same_v<F, std::multiplies<T>> || std::is_same_v<F, std::multiplies<>>;
+  static constexpr bool is_min = std::is_same_v<F, Minimum>;
+  static constexpr bool is_max = std::is_same_v<F, Maximum>;
+
+  static constexpr bool exists =
+          kernel::has_kernels_v<T> && std::is_integral_v<T>
+          && (is_sum || is_product || is_min || is_max);
+
+  static T apply(const T *xs, size_t n) {
+    if constexpr (is_sum) {
+      return kernel::sum(xs, n);
+    } else if constexpr (is_product) {
+      return kernel::product(xs, n);
+    } else if constexpr (is_min) {
+      return kernel::min(xs, n);
+    } else {
+      return kernel::max(xs, n);
+    }
+  }
+};
+
 template<typename T, typename F>
 class Fold : public Expression<Fold<T, F>> {
  public:
@@ -12,13 +47,32 @@ class Fold : public Expression<Fold<T, F>> {
 
   template<typename I>
   OutputType<Fold<T, F>, I> apply(iterator::Iterator<I> &&iter) const {
-    T result = initial;
+    if constexpr (is_integer_range_v<I> && std::is_same_v<T, iterator::OutputType<I>>
+                  && FoldKernel<F, T>::is_sum) {
+      auto &range = static_cast<I &>(iter);
+      auto hint = range.size_hint();
 
-    for (auto content = iter.next(); content.has_value();
-         content = iter.next()) {
-      result = func(std::move(result), std::move(content.value()));
+      if (hint.lower == 0) { return initial; }
+      if (hint.upper.has_value()) {
+        T partial = range.sum();
+        range.advance(hint.lower);
+        return func(initial, partial);
+      }
     }
 
+    if constexpr (uses_kernels_v<I> && std::is_same_v<T, iterator::OutputType<I>>
+                  && FoldKernel<F, T>::exists) {
+      auto partial = reduce_in_place(static_cast<I &>(iter), FoldKernel<F, T>::apply);
+      return partial.has_value() ? func(initial, *partial) : initial;
+    }
+
+    T result = initial;
+
+    iter.for_each_while([&](auto &&content) {
+      result = func(std::move(result), std::forward<decltype(content)>(content));
+      return true;
+    });
+
     return result;
   }
 
@@ -39,13 +93,20 @@ class Fold1 : public Expression<Fold1<F>> {
 
   template<typename I>
   OutputType<Fold1<F>, I> apply(iterator::Iterator<I> &&iter) const {
-    OutputType<Fold1<F>, I> result = iter.next().value();
+    using T = iterator::OutputType<I>;
 
-    for (auto content = iter.next(); content.has_value();
-         content = iter.next()) {
-      result = func(std::move(result), std::move(content.value()));
+    if constexpr (uses_kernels_v<I> && std::is_same_v<OutputType<Fold1<F>, I>, T>
+                  && FoldKernel<F, T>::exists) {
+      return reduce_in_place(static_cast<I &>(iter), FoldKernel<F, T>::apply).value();
     }
 
+    OutputType<Fold1<F>, I> result = iter.next().value();
+
+    iter.for_each_while([&](auto &&content) {
+      result = func(std::move(result), std::forward<decltype(content)>(content));
+      return true;
+    });
+
     return result;
   }
 
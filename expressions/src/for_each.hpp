@@ -11,10 +11,10 @@ class ForEach : public Expression<ForEach<F>> {
 
   template<typename I>
   OutputType<ForEach<F>, I> apply(iterator::Iterator<I> &&iter) const {
-    for (auto content = iter.next(); content.has_value();
-         content = iter.next()) {
-      func(std::move(content.value()));
-    }
+    iter.for_each_while([&](auto &&content) {
+      func(std::forward<decltype(content)>(content));
+      return true;
+    });
   }
 
  private:
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+#include "composition.hpp"
+#include "drop.hpp"
+#include "filter.hpp"
+#include "map.hpp"
+#include "map_filter.hpp"
+#include "take.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace colex::expression {
+
+/**
+ * `g` applied to the result of `f`
+ */
+template<typename F, typename G>
+struct Compose {
+  F f;
+  G g;
+
+  template<typename T>
+  auto operator()(T &&x) -> decltype(g(f(std::forward<T>(x)))) {
+    return g(f(std::forward<T>(x)));
+  }
+
+  template<typename T>
+  auto operator()(T &&x) const -> decltype(g(f(std::forward<T>(x)))) {
+    return g(f(std::forward<T>(x)));
+  }
+};
+
+/**
+ * True if both `p` and `q` are satisfied. `q` is only
+ * evaluated if `p` is.
+ */
+template<typename P, typename Q>
+struct Both {
+  P p;
+  Q q;
+
+  template<typename T>
+  bool operator()(T &x) {
+    return p(x) && q(x);
+  }
+
+  template<typename T>
+  bool operator()(T &x) const {
+    return p(x) && q(x);
+  }
+};
+
+/**
+ * `map(f) | map(g)` becomes `map(g . f)`
+ */
+template<typename F, typename G>
+struct Fusion<Map<F>, Map<G>> {
+  static constexpr bool fuses = true;
+
+  static Map<Compose<F, G>> fuse(const Map<F> &e1, const Map<G> &e2) {
+    return Map<Compose<F, G>>(Compose<F, G>{e1.function(), e2.function()});
+  }
+};
+
+/**
+ * `map(f) | filter(p)` becomes a single map-filter stage
+ */
+template<typename F, typename P>
+struct Fusion<Map<F>, Filter<P>> {
+  static constexpr bool fuses = true;
+
+  static MapFilter<F, P> fuse(const Map<F> &e1, const Filter<P> &e2) {
+    return MapFilter<F, P>(e1.function(), e2.function());
+  }
+};
+
+/**
+ * `filter(p) | filter(q)` becomes `filter(p && q)`
+ */
+template<typename P, typename Q>
+struct Fusion<Filter<P>, Filter<Q>> {
+  static constexpr bool fuses = true;
+
+  static Filter<Both<P, Q>> fuse(const Filter<P> &e1, const Filter<Q> &e2) {
+    return Filter<Both<P, Q>>(Both<P, Q>{e1.function(), e2.function()});
+  }
+};
+
+/**
+ * A map-filter followed by another filter tests both predicates
+ */
+template<typename F, typename P, typename Q>
+struct Fusion<MapFilter<F, P>, Filter<Q>> {
+  static constexpr bool fuses = true;
+
+  static MapFilter<F, Both<P, Q>> fuse(const MapFilter<F, P> &e1,
+                                       const Filter<Q> &e2) {
+    return MapFilter<F, Both<P, Q>>(
+            e1.function(), Both<P, Q>{e1.predicate(), e2.function()});
+  }
+};
+
+/**
+ * `take(a) | take(b)` becomes `take(min(a, b))`
+ */
+template<>
+struct Fusion<Take, Take> {
+  static constexpr bool fuses = true;
+
+  static Take fuse(const Take &e1, const Take &e2) {
+    return Take(std::min(e1.count(), e2.count()));
+  }
+};
+
+/**
+ * `drop(a) | drop(b)` becomes `drop(a + b)`
+ */
+template<>
+struct Fusion<Drop, Drop> {
+  static constexpr bool fuses = true;
+
+  static Drop fuse(const Drop &e1, const Drop &e2) {
+    size_t max = std::numeric_limits<size_t>::max();
+    return Drop(e1.count() > max - e2.count() ? max : e1.count() + e2.count());
+  }
+};
+
+}
@@ -14,6 +14,8 @@ class Map : public Expression<Map<F>> {
     return iterator::Map<F, I>(func, std::move(iter));
   }
 
+  [[nodiscard]] const F &function() const { return func; }
+
  private:
   F func;
 };
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+namespace colex::expression {
+
+/**
+ * A map followed by a filter. Created by fusing `map(f) | filter(p)`.
+ */
+template<typename F, typename P>
+class MapFilter : public Expression<MapFilter<F, P>> {
+ public:
+  explicit MapFilter(F func, P predicate)
+          : m_func(std::move(func)), m_predicate(std::move(predicate)) {}
+
+  template<typename I>
+  OutputType<MapFilter<F, P>, I> apply(iterator::Iterator<I> &&iter) const {
+    return iterator::MapFilter<F, P, I>(m_func, m_predicate, std::move(iter));
+  }
+
+  [[nodiscard]] const F &function() const { return m_func; }
+
+  [[nodiscard]] const P &predicate() const { return m_predicate; }
+
+ private:
+  F m_func;
+  P m_predicate;
+};
+
+template<typename F, typename P, typename I>
+struct Types<MapFilter<F, P>, I> {
+  using Output = iterator::MapFilter<F, P, I>;
+};
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include "executors/inc/executors.hpp"
+
+namespace colex::expression {
+
+template<typename E>
+class ParChunkMap : public Expression<ParChunkMap<E>> {
+ public:
+  explicit ParChunkMap(size_t size, Expression<E> &&expr,
+                       executor::ThreadPool &pool, size_t max_in_flight)
+          : m_size(size), m_expr(static_cast<E &&>(expr)), m_pool(&pool),
+            m_max_in_flight(max_in_flight) {}
+
+  template<typename I>
+  OutputType<ParChunkMap, I> apply(iterator::Iterator<I> &&iter) const {
+    return iterator::ParChunkMap<E, I>(m_size, m_expr, *m_pool,
+                                       m_max_in_flight, std::move(iter));
+  }
+
+ private:
+  size_t m_size;
+  E m_expr;
+  executor::ThreadPool *m_pool;
+  size_t m_max_in_flight;
+};
+
+template<typename E, typename I>
+struct Types<ParChunkMap<E>, I> {
+  using Output = iterator::ParChunkMap<E, I>;
+};
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include "executors/inc/executors.hpp"
+
+namespace colex::expression {
+
+template<typename F>
+class ParMap : public Expression<ParMap<F>> {
+ public:
+  explicit ParMap(F func, executor::ThreadPool &pool, size_t morsel_size)
+          : m_func(std::move(func)), m_pool(&pool), m_morsel_size(morsel_size) {}
+
+  template<typename I>
+  OutputType<ParMap<F>, I> apply(iterator::Iterator<I> &&iter) const {
+    return iterator::ParMap<F, I>(m_func, *m_pool, m_morsel_size,
+                                  std::move(iter));
+  }
+
+ private:
+  F m_func;
+  executor::ThreadPool *m_pool;
+  size_t m_morsel_size;
+};
+
+template<typename F, typename I>
+struct Types<ParMap<F>, I> {
+  using Output = iterator::ParMap<F, I>;
+};
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include "executors/inc/executors.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace colex::expression {
+
+template<typename E>
+class ParPartitionMap : public Expression<ParPartitionMap<E>> {
+ public:
+  explicit ParPartitionMap(std::vector<size_t> partition_sizes,
+                           Expression<E> &&expr, executor::ThreadPool &pool)
+          : m_partition_sizes(iterator::make_partition_sizes(partition_sizes)),
+            m_expr(static_cast<E &&>(expr)), m_pool(&pool) {}
+
+  template<typename I>
+  OutputType<ParPartitionMap<E>, I> apply(iterator::Iterator<I> &&iter) const {
+    return iterator::ParPartitionMap<E, I>(m_partition_sizes, m_expr, *m_pool,
+                                           std::move(iter));
+  }
+
+ private:
+  iterator::PartitionSizes m_partition_sizes;
+  E m_expr;
+  executor::ThreadPool *m_pool;
+};
+
+template<typename E, typename I>
+struct Types<ParPartitionMap<E>, I> {
+  using Output = iterator::ParPartitionMap<E, I>;
+};
+
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include "executors/inc/executors.hpp"
+
+#include <deque>
+#include <future>
+#include <vector>
+
+namespace colex::expression {
+
+/**
+ * A fold where pieces of the input are folded on a thread pool and the
+ * partial results are then combined. Splittable iterators are cut into
+ * a few blocks per worker. Other iterators are pulled on the calling
+ * thread in morsels that are folded by the workers.
+ */
+template<typename T, typename F, typename G>
+class ParReduce : public Expression<ParReduce<T, F, G>> {
+ public:
+  explicit ParReduce(T identity, F func, G combine,
+                     executor::ThreadPool &pool, size_t morsel_size)
+          : m_identity(std::move(identity)), m_func(std::move(func)),
+            m_combine(std::move(combine)), m_pool(&pool),
+            m_morsel_size(std::max<size_t>(1, morsel_size)) {}
+
+  template<typename I>
+  OutputType<ParReduce<T, F, G>, I> apply(iterator::Iterator<I> &&iter) const {
+    if constexpr (iterator::is_splittable_v<I>) {
+      return reduce_blocks(static_cast<I &&>(iter));
+    } else {
+      return reduce_morsels(static_cast<I &&>(iter));
+    }
+  }
+
+ private:
+  template<typename I>
+  T fold(I &&iter) const {
+    T result = m_identity;
+
+    iter.for_each_while([&](auto &&content) {
+      result = m_func(std::move(result), std::forward<decltype(content)>(content));
+      return true;
+    });
+
+    return result;
+  }
+
+  template<typename I>
+  T reduce_blocks(I iter) const {
+    size_t count = iter.size_hint().lower;
+    size_t blocks = std::min(4 * m_pool->thread_count(),
+                             count / m_morsel_size);
+    if (blocks < 2) { return fold(std::move(iter)); }
+
+    std::deque<std::future<T>> in_flight;
+    for (size_t block = 0; block < blocks; ++block) {
+      size_t size = count / blocks + (block < count % blocks);
+      in_flight.push_back(m_pool->submit(
+              [this, part = iter.split(size)]() mutable {
+                return fold(std::move(part));
+              }));
+    }
+
+    std::vector<T> partials;
+    partials.reserve(blocks);
+    drain(in_flight, partials, 0);
+
+    return combine(std::move(partials));
+  }
+
+  template<typename I>
+  T reduce_morsels(I iter) const {
+    using Input = iterator::OutputType<I>;
+
+    size_t max_in_flight = 2 * m_pool->thread_count();
+    std::deque<std::future<T>> in_flight;
+    std::vector<T> partials;
+    bool exhausted = false;
+
+    while (!exhausted) {
+      std::vector<Input> morsel;
+      morsel.reserve(m_morsel_size);
+
+      exhausted = iter.for_each_while([&](auto &&content) {
+        morsel.push_back(std::forward<decltype(content)>(content));
+        return morsel.size() < m_morsel_size;
+      });
+
+      if (morsel.empty()) { break; }
+
+      in_flight.push_back(m_pool->submit(
+              [this, morsel = std::move(morsel)]() mutable {
+                T result = m_identity;
+                for (auto &content : morsel) {
+                  result = m_func(std::move(result), std::move(content));
+                }
+                return result;
+              }));
+
+      drain(in_flight, partials, max_in_flight - 1);
+    }
+
+    drain(in_flight, partials, 0);
+
+    return combine(std::move(partials));
+  }
+
+  /**
+   * Moves the oldest results into `partials` until at most `keep` are
+   * in flight. If a task threw, the rest are waited for before the
+   * exception is rethrown, since they refer to this expression.
+   */
+  void drain(std::deque<std::future<T>> &in_flight, std::vector<T> &partials,
+             size_t keep) const {
+    try {
+      while (in_flight.size() > keep) {
+        m_pool->wait(in_flight.front());
+        partials.push_back(in_flight.front().get());
+        in_flight.pop_front();
+      }
+    } catch (...) {
+      for (auto &result : in_flight) {
+        if (result.valid()) { m_pool->wait(result); }
+      }
+      throw;
+    }
+  }
+
+  /**
+   * Combines the partial results pairwise, so the
+   * grouping only depends on the number of partials.
+   */
+  T combine(std::vector<T> partials) const {
+    if (partials.empty()) { return m_identity; }
+
+    for (size_t stride = 1; stride < partials.size(); stride *= 2) {
+      for (size_t i = 0; i + stride < partials.size(); i += 2 * stride) {
+        partials[i] = m_combine(std::move(partials[i]),
+                                std::move(partials[i + stride]));
+      }
+    }
+
+    return std::move(partials[0]);
+  }
+
+  T m_identity;
+  F m_func;
+  G m_combine;
+  executor::ThreadPool *m_pool;
+  size_t m_morsel_size;
+};
+
+template<typename T, typename F, typename G, typename I>
+struct Types<ParReduce<T, F, G>, I> {
+  using Output = T;
+};
+
+}
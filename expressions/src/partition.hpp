@@ -2,12 +2,15 @@
 
 #include "../inc/interface.hpp"
 
+#include <memory>
+#include <vector>
+
 namespace colex::expression {
 
 class Partition : public Expression<Partition> {
  public:
   explicit Partition(std::vector<size_t> partition_sizes)
-          : m_partition_sizes(std::move(partition_sizes)) {}
+          : m_partition_sizes(iterator::make_partition_sizes(partition_sizes)) {}
 
   template<typename I>
   OutputType<Partition, I> apply(iterator::Iterator<I> &&iter) const {
@@ -15,7 +18,7 @@ class Partition : public Expression<Partition> {
   }
 
  private:
-  std::vector<size_t> m_partition_sizes;
+  iterator::PartitionSizes m_partition_sizes;
 };
 
 template<typename I>
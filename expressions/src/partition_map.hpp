@@ -2,6 +2,9 @@
 
 #include "../inc/interface.hpp"
 
+#include <memory>
+#include <vector>
+
 namespace colex::expression {
 
 template<typename E>
@@ -9,7 +12,7 @@ class PartitionMap : public Expression<PartitionMap<E>> {
  public:
   explicit PartitionMap(std::vector<size_t> partition_sizes,
                         Expression<E> &&expr)
-          : m_partition_sizes(std::move(partition_sizes)),
+          : m_partition_sizes(iterator::make_partition_sizes(partition_sizes)),
             m_expr(static_cast<E &&>(expr)) {}
 
   template<typename I>
@@ -18,7 +21,7 @@ class PartitionMap : public Expression<PartitionMap<E>> {
   }
 
  private:
-  std::vector<size_t> m_partition_sizes;
+  iterator::PartitionSizes m_partition_sizes;
   E m_expr;
 };
 
@@ -2,26 +2,38 @@
 
 #include "../inc/interface.hpp"
 
+#include "iterators/inc/iterators.hpp"
+
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <vector>
+
 namespace colex::expression {
 
+/**
+ * The items are kept in memory from the current resource
+ */
 template<typename T>
 class Prepend : public Expression<Prepend<T>> {
  public:
-  Prepend(std::vector<T> xs) : m_xs(std::move(xs)) {}
-  Prepend(std::initializer_list<T> xs) : m_xs(xs) {}
+  Prepend(std::vector<T> xs)
+          : m_xs(std::make_move_iterator(xs.begin()), std::make_move_iterator(xs.end()),
+                 iterator::current_resource()) {}
+  Prepend(std::initializer_list<T> xs) : m_xs(xs, iterator::current_resource()) {}
 
   template<typename I>
   OutputType<Prepend<T>, I> apply(iterator::Iterator<I> &&iter) const {
-    return iterator::Concat(iterator::STL(m_xs), std::move(iter));
+    return iterator::Concat(iterator::STL<std::pmr::vector, T>(m_xs), std::move(iter));
   }
 
  private:
-  std::vector<T> m_xs;
+  std::pmr::vector<T> m_xs;
 };
 
 template<typename T, typename I>
 struct Types<Prepend<T>, I> {
-  using Output = iterator::Concat<iterator::STL<std::vector, T>, I>;
+  using Output = iterator::Concat<iterator::STL<std::pmr::vector, T>, I>;
 };
 
 }
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include "kernels/inc/kernels.hpp"
+
+namespace colex::expression {
+
+/**
+ * Function object returning the smaller of two values.
+ * Returns the first one if they are equal.
+ */
+struct Minimum {
+  template<typename T>
+  T operator()(T a, T b) const { return b < a ? b : a; }
+};
+
+/**
+ * Function object returning the larger of two values.
+ * Returns the first one if they are equal.
+ */
+struct Maximum {
+  template<typename T>
+  T operator()(T a, T b) const { return a < b ? b : a; }
+};
+
+/**
+ * True if the items of `I` can be handed to the reduction kernels in place
+ */
+template<typename I>
+constexpr bool uses_kernels_v =
+        iterator::is_contiguous_v<I>
+        && kernel::has_kernels_v<std::remove_cv_t<iterator::OutputType<I>>>;
+
+/**
+ * True if `I` is a range of integers, which can be summed in closed form
+ */
+template<typename I>
+struct IsIntegerRange : std::false_type {};
+
+template<typename T>
+struct IsIntegerRange<iterator::Range<T>> : std::is_integral<T> {};
+
+template<typename I>
+constexpr bool is_integer_range_v = IsIntegerRange<I>::value;
+
+/**
+ * Consumes a contiguous iterator with `reduce(items, count)`.
+ * Returns none if it is empty.
+ */
+template<typename I, typename R>
+auto reduce_in_place(I &source, R reduce)
+        -> std::optional<decltype(reduce(source.data(), size_t(0)))> {
+  size_t count = source.size_hint().lower;
+  if (count == 0) { return {}; }
+
+  auto result = reduce(source.data(), count);
+  source.advance(count);
+
+  return result;
+}
+
+class Sum : public Expression<Sum> {
+ public:
+  template<typename I>
+  OutputType<Sum, I> apply(iterator::Iterator<I> &&iter) const {
+    using T = OutputType<Sum, I>;
+
+    if constexpr (is_integer_range_v<I>) {
+      auto &range = static_cast<I &>(iter);
+
+      if (range.size_hint().upper.has_value()) {
+        T result = range.sum();
+        range.advance(range.size_hint().lower);
+
+        return result;
+      }
+    }
+
+    if constexpr (uses_kernels_v<I>) {
+      return reduce_in_place(static_cast<I &>(iter), [](const T *xs, size_t n) {
+        return kernel::sum(xs, n);
+      }).value_or(T(0));
+    } else {
+      T result{};
+
+      iter.for_each_while([&](auto &&content) {
+        result = std::move(result) + std::forward<decltype(content)>(content);
+        return true;
+      });
+
+      return result;
+    }
+  }
+};
+
+template<typename I>
+struct Types<Sum, I> {
+  using Output = std::remove_cv_t<iterator::OutputType<I>>;
+};
+
+class Min : public Expression<Min> {
+ public:
+  template<typename I>
+  OutputType<Min, I> apply(iterator::Iterator<I> &&iter) const {
+    using T = iterator::OutputType<I>;
+
+    if constexpr (uses_kernels_v<I>) {
+      return reduce_in_place(static_cast<I &>(iter), [](const T *xs, size_t n) {
+        return kernel::min(xs, n);
+      });
+    } else {
+      OutputType<Min, I> result = iter.next();
+      if (!result.has_value()) { return result; }
+
+      iter.for_each_while([&](auto &&content) {
+        *result = Minimum()(std::move(*result), std::forward<decltype(content)>(content));
+        return true;
+      });
+
+      return result;
+    }
+  }
+};
+
+template<typename I>
+struct Types<Min, I> {
+  using Output = std::optional<iterator::OutputType<I>>;
+};
+
+class Max : public Expression<Max> {
+ public:
+  template<typename I>
+  OutputType<Max, I> apply(iterator::Iterator<I> &&iter) const {
+    using T = iterator::OutputType<I>;
+
+    if constexpr (uses_kernels_v<I>) {
+      return reduce_in_place(static_cast<I &>(iter), [](const T *xs, size_t n) {
+        return kernel::max(xs, n);
+      });
+    } else {
+      OutputType<Max, I> result = iter.next();
+      if (!result.has_value()) { return result; }
+
+      iter.for_each_while([&](auto &&content) {
+        *result = Maximum()(std::move(*result), std::forward<decltype(content)>(content));
+        return true;
+      });
+
+      return result;
+    }
+  }
+};
+
+template<typename I>
+struct Types<Max, I> {
+  using Output = std::optional<iterator::OutputType<I>>;
+};
+
+class MinMax : public Expression<MinMax> {
+ public:
+  template<typename I>
+  OutputType<MinMax, I> apply(iterator::Iterator<I> &&iter) const {
+    using T = iterator::OutputType<I>;
+
+    if constexpr (uses_kernels_v<I>) {
+      return reduce_in_place(static_cast<I &>(iter), [](const T *xs, size_t n) {
+        return kernel::minmax(xs, n);
+      });
+    } else {
+      auto first = iter.next();
+      if (!first.has_value()) { return {}; }
+
+      T smallest = *first;
+      T largest = std::move(*first);
+
+      iter.for_each_while([&](auto &&content) {
+        if (content < smallest) {
+          smallest = std::forward<decltype(content)>(content);
+        } else if (largest < content) {
+          largest = std::forward<decltype(content)>(content);
+        }
+        return true;
+      });
+
+      return std::pair<T, T>(std::move(smallest), std::move(largest));
+    }
+  }
+};
+
+template<typename I>
+struct Types<MinMax, I> {
+  using Output = std::optional<std::pair<iterator::OutputType<I>, iterator::OutputType<I>>>;
+};
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include <functional>
+
+namespace colex::expression {
+
+class RollingSum : public Expression<RollingSum> {
+ public:
+  explicit RollingSum(size_t window) : m_window(window) {}
+
+  template<typename I>
+  OutputType<RollingSum, I> apply(iterator::Iterator<I> &&iter) const {
+    return iterator::RollingSum<I>(m_window, std::move(iter));
+  }
+
+ private:
+  size_t m_window;
+};
+
+template<typename I>
+struct Types<RollingSum, I> {
+  using Output = iterator::RollingSum<I>;
+};
+
+class RollingMean : public Expression<RollingMean> {
+ public:
+  explicit RollingMean(size_t window) : m_window(std::max<size_t>(1, window)) {}
+
+  template<typename I>
+  OutputType<RollingMean, I> apply(iterator::Iterator<I> &&iter) const {
+    using Mean = iterator::Mean<iterator::OutputType<I>>;
+    return OutputType<RollingMean, I>(
+            Mean{m_window}, iterator::RollingSum<I>(m_window, std::move(iter)));
+  }
+
+ private:
+  size_t m_window;
+};
+
+template<typename I>
+struct Types<RollingMean, I> {
+  using Output = iterator::Map<iterator::Mean<iterator::OutputType<I>>,
+                               iterator::RollingSum<I>>;
+};
+
+template<typename C>
+class RollingExtreme : public Expression<RollingExtreme<C>> {
+ public:
+  explicit RollingExtreme(size_t window) : m_window(window) {}
+
+  template<typename I>
+  OutputType<RollingExtreme<C>, I> apply(iterator::Iterator<I> &&iter) const {
+    return iterator::RollingExtreme<C, I>(m_window, std::move(iter));
+  }
+
+ private:
+  size_t m_window;
+};
+
+template<typename C, typename I>
+struct Types<RollingExtreme<C>, I> {
+  using Output = iterator::RollingExtreme<C, I>;
+};
+
+using RollingMin = RollingExtreme<std::less<>>;
+using RollingMax = RollingExtreme<std::greater<>>;
+
+}
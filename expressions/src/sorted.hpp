@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace colex::expression {
+
+/**
+ * Buffers the input in a vector, sorts it with `std::sort` and yields
+ * the items in order, marked as sorted for the collectors
+ */
+class Sorted : public Expression<Sorted> {
+ public:
+  template<typename I>
+  OutputType<Sorted, I> apply(iterator::Iterator<I> &&iter) const {
+    std::vector<iterator::OutputType<I>> items;
+    items.reserve(iter.size_hint().lower);
+
+    iter.for_each_while([&](auto &&content) {
+      items.push_back(std::forward<decltype(content)>(content));
+      return true;
+    });
+
+    std::sort(items.begin(), items.end());
+
+    return OutputType<Sorted, I>(
+            iterator::STLMove<std::vector, iterator::OutputType<I>>(std::move(items)));
+  }
+};
+
+template<typename I>
+struct Types<Sorted, I> {
+  using Output = iterator::Sorted<
+          iterator::STLMove<std::vector, iterator::OutputType<I>>>;
+};
+
+/**
+ * Marks the input as sorted without buffering it. The order is not
+ * checked: unsorted input only makes the set and map collectors slower,
+ * but gives invalid `container::flat_set` and `container::flat_map`
+ */
+class AssumeSorted : public Expression<AssumeSorted> {
+ public:
+  template<typename I>
+  OutputType<AssumeSorted, I> apply(iterator::Iterator<I> &&iter) const {
+    return iterator::Sorted<I>(std::move(iter));
+  }
+};
+
+template<typename I>
+struct Types<AssumeSorted, I> {
+  using Output = iterator::Sorted<I>;
+};
+
+}
@@ -2,24 +2,38 @@
 
 #include "../inc/interface.hpp"
 
+#include <type_traits>
+
 namespace colex::expression {
 
 class Take : public Expression<Take> {
  public:
-  explicit Take(size_t count) : count(count) {}
+  explicit Take(size_t count) : m_count(count) {}
 
   template<typename I>
   OutputType<Take, I> apply(iterator::Iterator<I> &&iter) const {
-    return iterator::Take<I>(count, std::move(iter));
+    if constexpr (iterator::is_random_access_v<I>) {
+      I result = static_cast<I &&>(iter);
+      result.truncate(m_count);
+      return result;
+    } else {
+      return iterator::Take<I>(m_count, std::move(iter));
+    }
   }
 
+  [[nodiscard]] size_t count() const { return m_count; }
+
  private:
-  size_t count;
+  size_t m_count;
 };
 
+/**
+ * Random access iterators are truncated in place instead of wrapped
+ */
 template<typename I>
 struct Types<Take, I> {
-  using Output = iterator::Take<I>;
+  using Output = std::conditional_t<iterator::is_random_access_v<I>, I,
+                                    iterator::Take<I>>;
 };
 
 }
@@ -20,4 +20,23 @@ struct Types<Window<N>, I> {
   using Output = iterator::Window<N, I>;
 };
 
+class DynamicWindow : public Expression<DynamicWindow> {
+ public:
+  explicit DynamicWindow(size_t size, size_t hop) : m_size(size), m_hop(hop) {}
+
+  template<typename I>
+  OutputType<DynamicWindow, I> apply(iterator::Iterator<I> &&iter) const {
+    return iterator::DynamicWindow<I>(m_size, m_hop, std::move(iter));
+  }
+
+ private:
+  size_t m_size;
+  size_t m_hop;
+};
+
+template<typename I>
+struct Types<DynamicWindow, I> {
+  using Output = iterator::DynamicWindow<I>;
+};
+
 }
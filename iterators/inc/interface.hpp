@@ -1,6 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <array>
 #include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace colex::iterator {
 
@@ -19,6 +28,250 @@ struct Types;
 template<typename I>
 using OutputType = typename Types<I>::Output;
 
+/**
+ * Bounds on the number of elements an iterator has left.
+ * `upper` is none if there is no known upper bound.
+ */
+struct SizeHint {
+  size_t lower;
+  std::optional<size_t> upper;
+
+  /**
+   * A hint for an iterator with exactly `n` elements left
+   */
+  static SizeHint exact(size_t n) { return {n, n}; }
+
+  /**
+   * A hint for an iterator we know nothing about
+   */
+  static SizeHint unknown() { return {0, {}}; }
+
+  /**
+   * A hint for an iterator that never ends
+   */
+  static SizeHint infinite() {
+    return {std::numeric_limits<size_t>::max(), {}};
+  }
+
+  /**
+   * True if the lower and upper bounds are equal
+   */
+  [[nodiscard]] bool is_exact() const {
+    return upper.has_value() && upper.value() == lower;
+  }
+};
+
+/**
+ * Adds `a` and `b` without overflowing
+ */
+inline size_t saturating_add(size_t a, size_t b) {
+  return a > std::numeric_limits<size_t>::max() - b
+         ? std::numeric_limits<size_t>::max()
+         : a + b;
+}
+
+/**
+ * The hint of an iterator yielding the elements of both `a` and `b`
+ */
+inline SizeHint operator+(const SizeHint &a, const SizeHint &b) {
+  std::optional<size_t> upper;
+  if (a.upper.has_value() && b.upper.has_value()
+      && a.upper.value() <= std::numeric_limits<size_t>::max() - b.upper.value()) {
+    upper = a.upper.value() + b.upper.value();
+  }
+
+  return {saturating_add(a.lower, b.lower), upper};
+}
+
+/**
+ * The hint of an iterator that stops when either `a` or `b` stops
+ */
+inline SizeHint min(const SizeHint &a, const SizeHint &b) {
+  std::optional<size_t> upper = a.upper;
+  if (!upper.has_value() || (b.upper.has_value() && b.upper.value() < upper.value())) {
+    upper = b.upper;
+  }
+
+  return {std::min(a.lower, b.lower), upper};
+}
+
+/**
+ * The hint of an iterator yielding at most `n` elements of `a`
+ */
+inline SizeHint clamp(const SizeHint &a, size_t n) {
+  return {std::min(a.lower, n),
+          a.upper.has_value() ? std::min(a.upper.value(), n) : n};
+}
+
+/**
+ * The number of items batched consumers request at a time
+ */
+constexpr size_t batch_size = 512;
+
+/**
+ * True if `T` is cheap enough to stage in a batch buffer on the stack
+ */
+template<typename T>
+constexpr bool is_batchable_v = std::is_trivially_copyable_v<T>
+                             && std::is_default_constructible_v<T>
+                             && sizeof(T) <= 64;
+
+/**
+ * True if `I` has a specialized `next_batch`. Iterators opt in by
+ * defining `static constexpr bool batched = true`.
+ */
+template<typename I, typename = void>
+struct IsBatched : std::false_type {};
+
+template<typename I>
+struct IsBatched<I, std::void_t<decltype(I::batched)>>
+        : std::bool_constant<I::batched> {};
+
+template<typename I>
+constexpr bool is_batched_v = IsBatched<I>::value;
+
+/**
+ * True if the STL iterator `It` supports constant time jumps
+ */
+template<typename It>
+constexpr bool is_random_access_iterator_v = std::is_base_of_v<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<It>::iterator_category>;
+
+/**
+ * True if `I` can skip and cut off items in constant time. Such
+ * iterators define `static constexpr bool random_access = true`
+ * as well as `advance(n)`, which skips the next `n` items, and
+ * `truncate(n)`, which drops everything after the next `n` items.
+ */
+template<typename I, typename = void>
+struct IsRandomAccess : std::false_type {};
+
+template<typename I>
+struct IsRandomAccess<I, std::void_t<decltype(I::random_access)>>
+        : std::bool_constant<I::random_access> {};
+
+template<typename I>
+constexpr bool is_random_access_v = IsRandomAccess<I>::value;
+
+/**
+ * True if the remaining items of `I` lie next to each other in memory.
+ * Such iterators are random access and define
+ * `static constexpr bool contiguous = true` as well as `data()`,
+ * which points to the next item.
+ */
+template<typename I, typename = void>
+struct IsContiguous : std::false_type {};
+
+template<typename I>
+struct IsContiguous<I, std::void_t<decltype(I::contiguous)>>
+        : std::bool_constant<I::contiguous> {};
+
+template<typename I>
+constexpr bool is_contiguous_v = IsContiguous<I>::value;
+
+/**
+ * True if `I` can be cut into independent pieces in constant time.
+ * Such iterators define `static constexpr bool splittable = true`
+ * as well as `split(n)`, which returns an iterator of the same type
+ * over the next `n` items and advances past them.
+ */
+template<typename I, typename = void>
+struct IsSplittable : std::false_type {};
+
+template<typename I>
+struct IsSplittable<I, std::void_t<decltype(I::splittable)>>
+        : std::bool_constant<I::splittable> {};
+
+template<typename I>
+constexpr bool is_splittable_v = IsSplittable<I>::value;
+
+/**
+ * True if `I` yields its items in ascending order by `operator<`.
+ * Such iterators define `static constexpr bool sorted = true`.
+ */
+template<typename I, typename = void>
+struct IsSorted : std::false_type {};
+
+template<typename I>
+struct IsSorted<I, std::void_t<decltype(I::sorted)>>
+        : std::bool_constant<I::sorted> {};
+
+template<typename I>
+constexpr bool is_sorted_v = IsSorted<I>::value;
+
+/**
+ * True if the STL container `C` keeps its elements
+ * in ascending order by `operator<`, like `std::set` and `std::map`
+ */
+template<typename C, typename = void>
+struct IsOrderedContainer : std::false_type {};
+
+template<typename C>
+struct IsOrderedContainer<C, std::void_t<typename C::key_compare>>
+        : std::is_same<typename C::key_compare, std::less<typename C::key_type>> {};
+
+template<typename C>
+constexpr bool is_ordered_container_v = IsOrderedContainer<C>::value;
+
+/**
+ * True if inserting into `C` reports whether the key was new,
+ * i.e. `C` has unique keys
+ */
+template<typename C, typename = void>
+struct HasUniqueKeys : std::false_type {};
+
+template<typename C>
+struct HasUniqueKeys<C, std::void_t<decltype(std::declval<C &>().insert(
+        std::declval<const typename C::value_type &>()).second)>>
+        : std::true_type {};
+
+/**
+ * True if iterating over the ordered container `C` yields its elements
+ * in ascending order by `operator<`. Not true for `std::multimap`, which
+ * keeps equal keys in insertion order whatever their values.
+ */
+template<typename C, typename = void>
+struct IsSortedContainer : std::false_type {};
+
+template<typename C>
+struct IsSortedContainer<C, std::enable_if_t<is_ordered_container_v<C>>>
+        : std::disjunction<std::is_same<typename C::value_type, typename C::key_type>,
+                           HasUniqueKeys<C>> {};
+
+template<typename C>
+constexpr bool is_sorted_container_v = IsSortedContainer<C>::value;
+
+/**
+ * True for an `std::vector` with any allocator, except `std::vector<bool>`
+ */
+template<typename C>
+struct IsVector : std::false_type {};
+
+template<typename T, typename A>
+struct IsVector<std::vector<T, A>> : std::negation<std::is_same<T, bool>> {};
+
+template<typename C>
+constexpr bool is_vector_v = IsVector<C>::value;
+
+/**
+ * Writes up to `max` items of `iter` to `out` one at a time.
+ * This is what `next_batch` does for iterators without a
+ * specialized implementation.
+ */
+template<typename I>
+size_t fill_batch(I &iter, OutputType<I> *out, size_t max) {
+  if (max == 0) { return 0; }
+
+  size_t n = 0;
+  iter.for_each_while([&](auto &&content) {
+    out[n++] = std::forward<decltype(content)>(content);
+    return n < max;
+  });
+
+  return n;
+}
+
 /**
  * Base for all iterators
  */
@@ -30,6 +283,52 @@ struct Iterator {
   [[nodiscard]] std::optional<OutputType<I>> next() {
     return static_cast<I &>(*this).next();
   }
+
+  /**
+   * Returns bounds on the number of items left.
+   */
+  [[nodiscard]] SizeHint size_hint() const {
+    return static_cast<const I &>(*this).size_hint();
+  }
+
+  /**
+   * Calls `sink` with each remaining item until `sink` returns false.
+   * Returns false if `sink` stopped the iteration, and true if the
+   * iterator was exhausted. Unlike `next`, this lets each iterator
+   * drive its own loop, so no `std::optional` is created per item.
+   */
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    return static_cast<I &>(*this).for_each_while(std::forward<S>(sink));
+  }
+
+  /**
+   * Assigns up to `max` items to `out[0]`, `out[1]`, ... and returns
+   * how many were written. Fewer than `max` means the iterator is exhausted.
+   */
+  size_t next_batch(OutputType<I> *out, size_t max) {
+    if constexpr (is_batched_v<I>) {
+      return static_cast<I &>(*this).next_batch(out, max);
+    } else {
+      return fill_batch(static_cast<I &>(*this), out, max);
+    }
+  }
 };
 
+/**
+ * Calls `sink(items, count)` with consecutive blocks of at most
+ * `batch_size` items until `iter` is exhausted. Requires that
+ * the items are batchable.
+ */
+template<typename I, typename S>
+void for_each_batch(Iterator<I> &iter, S &&sink) {
+  std::array<OutputType<I>, batch_size> buffer;
+
+  for (;;) {
+    size_t n = iter.next_batch(buffer.data(), buffer.size());
+    if (n > 0) { sink(buffer.data(), n); }
+    if (n < buffer.size()) { return; }
+  }
+}
+
 }// namespace colex::iterator
@@ -8,17 +8,29 @@
 
 #include "../src/chunk.hpp"
 #include "../src/chunk_map.hpp"
+#include "../src/collector.hpp"
 #include "../src/drop.hpp"
 #include "../src/enumerate.hpp"
 #include "../src/filter.hpp"
 #include "../src/flat_map.hpp"
 #include "../src/flatten.hpp"
 #include "../src/function.hpp"
+#include "../src/inline.hpp"
 #include "../src/map.hpp"
+#include "../src/map_filter.hpp"
+#include "../src/nodes.hpp"
+#include "../src/par_chunk_map.hpp"
+#include "../src/par_map.hpp"
+#include "../src/par_partition_map.hpp"
 #include "../src/partition.hpp"
 #include "../src/partition_map.hpp"
 #include "../src/pointer.hpp"
 #include "../src/range.hpp"
+#include "../src/ref.hpp"
+#include "../src/resource.hpp"
+#include "../src/rolling.hpp"
 #include "../src/scan.hpp"
+#include "../src/sorted.hpp"
+#include "../src/span.hpp"
 #include "../src/window.hpp"
 #include "../src/zip.hpp"
@@ -4,6 +4,38 @@
 
 namespace colex::iterator {
 
+/**
+ * The type of the chunks cut from `I`. Splittable iterators are
+ * cut into iterators of their own type, so chunks of pointers and
+ * vectors stay contiguous and random access. Other iterators yield
+ * chunks that borrow the underlying iterator.
+ */
+template<typename I>
+using ChunkType = std::conditional_t<
+        is_splittable_v<I>, I, Concat<ArrayMove<OutputType<I>, 1>, TakeRef<I>>>;
+
+/**
+ * Cuts the next chunk of at most `size` items off `underlying`.
+ * None if there are no items left.
+ */
+template<typename I>
+std::optional<ChunkType<I>> next_chunk(I &underlying, size_t size) {
+  if constexpr (is_splittable_v<I>) {
+    if (size == 0 || underlying.size_hint().lower == 0) { return {}; }
+
+    return underlying.split(size);
+  } else {
+    auto it = TakeRef<I>(size, underlying);
+    auto first = it.next();
+    if (first.has_value()) {
+      return ChunkType<I>(ArrayMove(std::array{std::move(first.value())}),
+                          std::move(it));
+    }
+
+    return {};
+  }
+}
+
 template<typename I>
 class Chunk : public Iterator<Chunk<I>> {
  public:
@@ -16,14 +48,31 @@ class Chunk : public Iterator<Chunk<I>> {
   Chunk &operator=(const Chunk &) = delete;
 
   [[nodiscard]] std::optional<OutputType<Chunk<I>>> next() {
-    auto it = TakeRef<I>(size, underlying);
-    auto first = it.next();
-    if (first.has_value()) {
-      return Concat(ArrayMove(std::array{std::move(first.value())}),
-                    std::move(it));
+    return next_chunk(underlying, size);
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    // Chunks of size 0 are never produced
+    if (size == 0) { return SizeHint::exact(0); }
+
+    auto hint = underlying.size_hint();
+    auto chunks = [this](size_t n) { return n / size + (n % size != 0); };
+
+    if (hint.upper.has_value()) {
+      return {chunks(hint.lower), chunks(hint.upper.value())};
     }
 
-    return {};
+    return {chunks(hint.lower), {}};
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    for (;;) {
+      auto content = next();
+
+      if (!content.has_value()) { return true; }
+      if (!sink(std::move(content.value()))) { return false; }
+    }
   }
 
  private:
@@ -33,7 +82,7 @@ class Chunk : public Iterator<Chunk<I>> {
 
 template<typename I>
 struct Types<Chunk<I>> {
-  using Output = Concat<ArrayMove<OutputType<I>, 1>, TakeRef<I>>;
+  using Output = ChunkType<I>;
 };
 
 }
@@ -16,16 +16,36 @@ class ChunkMap : public Iterator<ChunkMap<E, I>> {
   ChunkMap &operator=(const ChunkMap &) = delete;
 
   [[nodiscard]] std::optional<OutputType<ChunkMap<E, I>>> next() {
-    auto it = TakeRef<I>(size, underlying);
-    auto first = it.next();
-    if (first.has_value()) {
-      return expr.apply(Concat(ArrayMove(std::array{std::move(first.value())}),
-                               std::move(it)));
-    }
+    auto chunk = next_chunk(underlying, size);
+    if (chunk.has_value()) { return expr.apply(std::move(chunk.value())); }
 
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    // Chunks of size 0 are never produced
+    if (size == 0) { return SizeHint::exact(0); }
+
+    auto hint = underlying.size_hint();
+    auto chunks = [this](size_t n) { return n / size + (n % size != 0); };
+
+    if (hint.upper.has_value()) {
+      return {chunks(hint.lower), chunks(hint.upper.value())};
+    }
+
+    return {chunks(hint.lower), {}};
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    for (;;) {
+      auto content = next();
+
+      if (!content.has_value()) { return true; }
+      if (!sink(std::move(content.value()))) { return false; }
+    }
+  }
+
  private:
   I underlying;
   size_t size;
@@ -34,8 +54,7 @@ class ChunkMap : public Iterator<ChunkMap<E, I>> {
 
 template<typename E, typename I>
 struct Types<ChunkMap<E, I>> {
-  using Output = expression::OutputType<
-  E, Concat<ArrayMove<OutputType<I>, 1>, TakeRef<I>>>;
+  using Output = expression::OutputType<E, ChunkType<I>>;
 };
 
 }
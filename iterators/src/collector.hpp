@@ -0,0 +1,133 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+#include "nodes.hpp"
+#include "resource.hpp"
+
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace colex::iterator {
+
+/**
+ * True if items can be appended to `C` with `emplace_back`, like
+ * `std::vector`, `std::deque` and their `std::pmr` variants
+ */
+template<typename C, typename T, typename = void>
+struct HasEmplaceBack : std::false_type {};
+
+template<typename C, typename T>
+struct HasEmplaceBack<C, T, std::void_t<decltype(std::declval<C &>().emplace_back(std::declval<T>()))>>
+        : std::true_type {};
+
+/**
+ * True if `C` can allocate room for more items up front
+ */
+template<typename C, typename = void>
+struct HasReserve : std::false_type {};
+
+template<typename C>
+struct HasReserve<C, std::void_t<decltype(std::declval<C &>().reserve(size_t(0))),
+                                 decltype(std::declval<const C &>().size())>>
+        : std::true_type {};
+
+template<typename C, typename = void>
+struct HasCapacity : std::false_type {};
+
+template<typename C>
+struct HasCapacity<C, std::void_t<decltype(std::declval<const C &>().capacity())>>
+        : std::true_type {};
+
+/**
+ * True if a range of `T`s can be appended to `C` at once
+ */
+template<typename C, typename T, typename = void>
+struct HasRangeInsert : std::false_type {};
+
+template<typename C, typename T>
+struct HasRangeInsert<C, T, std::void_t<decltype(std::declval<C &>().insert(
+        std::declval<C &>().end(), std::declval<const T *>(), std::declval<const T *>()))>>
+        : std::true_type {};
+
+/**
+ * True if `C` allocates from a memory resource, like the `std::pmr` containers
+ */
+template<typename C, typename = void>
+struct UsesResource : std::false_type {};
+
+template<typename C>
+struct UsesResource<C, std::void_t<typename C::allocator_type>>
+        : std::is_constructible<typename C::allocator_type, std::pmr::memory_resource *> {};
+
+/**
+ * Creates an empty `C`, which allocates from the current resource if it can
+ */
+template<typename C>
+C make_container() {
+  if constexpr (UsesResource<C>::value) {
+    return C(typename C::allocator_type(current_resource()));
+  } else {
+    return C();
+  }
+}
+
+/**
+ * Makes room for `n` more items in `container`, if it supports that.
+ * Containers with a capacity grow at least geometrically, so collecting
+ * into the same container repeatedly stays amortized linear.
+ */
+template<typename C>
+void reserve_more(C &container, size_t n) {
+  if constexpr (HasReserve<C>::value) {
+    size_t wanted = container.size() + n;
+
+    if constexpr (HasCapacity<C>::value) {
+      if (wanted <= container.capacity()) { return; }
+      wanted = std::max(wanted, 2 * container.capacity());
+    }
+
+    container.reserve(wanted);
+  }
+}
+
+/**
+ * Adds all items of `iter` to `container`. Sequences get contiguous and
+ * batched items in blocks and other items with `emplace_back`, and
+ * everything else gets them with `insert`. Sorted items are
+ * inserted at the end of containers ordered by `operator<`.
+ */
+template<typename C, typename I>
+void append_all(C &container, I &iter) {
+  using T = OutputType<I>;
+  reserve_more(container, iter.size_hint().lower);
+
+  if constexpr (HasRangeInsert<C, T>::value && is_contiguous_v<I>
+                && std::is_trivially_copyable_v<T>) {
+    size_t n = iter.size_hint().lower;
+    if (n > 0) {
+      container.insert(container.end(), iter.data(), iter.data() + n);
+      iter.advance(n);
+    }
+  } else if constexpr (HasRangeInsert<C, T>::value && is_batched_v<I> && is_batchable_v<T>) {
+    for_each_batch(iter, [&](const T *items, size_t count) {
+      container.insert(container.end(), items, items + count);
+    });
+  } else {
+    iter.for_each_while([&](auto &&content) {
+      using U = decltype(content);
+
+      if constexpr (HasEmplaceBack<C, U>::value) {
+        container.emplace_back(std::forward<U>(content));
+      } else if constexpr (is_sorted_v<I> && is_ordered_container_v<C>) {
+        insert_element(container, container.end(), std::forward<U>(content));
+      } else {
+        insert_element(container, std::forward<U>(content));
+      }
+
+      return true;
+    });
+  }
+}
+
+}
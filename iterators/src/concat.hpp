@@ -25,6 +25,15 @@ class Concat : public Iterator<Concat<I1, I2>> {
     return right.next();
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    return left.size_hint() + right.size_hint();
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    return left.for_each_while(sink) && right.for_each_while(sink);
+  }
+
  private:
   I1 left;
   I2 right;
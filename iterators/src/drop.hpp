@@ -7,10 +7,16 @@ namespace colex::iterator {
 template<typename I>
 class Drop : public Iterator<Drop<I>> {
  public:
+  static constexpr bool sorted = is_sorted_v<I>;
+
   explicit Drop(size_t count, Iterator<I> &&iter)
           : underlying(static_cast<I &&>(iter)) {
-    for (size_t i = 0; i < count; ++i) {
-      if (!underlying.next().has_value()) { break; }
+    if constexpr (is_random_access_v<I>) {
+      underlying.advance(count);
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        if (!underlying.next().has_value()) { break; }
+      }
     }
   }
 
@@ -23,6 +29,13 @@ class Drop : public Iterator<Drop<I>> {
     return underlying.next();
   }
 
+  [[nodiscard]] SizeHint size_hint() const { return underlying.size_hint(); }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    return underlying.for_each_while(sink);
+  }
+
  private:
   I underlying;
 };
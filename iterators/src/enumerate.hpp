@@ -19,12 +19,21 @@ class Enumerate : public Iterator<Enumerate<I>> {
     auto content = underlying.next();
 
     if (content.has_value()) {
-      return std::make_pair(i++, std::move(content.value()));
+      return OutputType<Enumerate<I>>(i++, std::move(content.value()));
     }
 
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const { return underlying.size_hint(); }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    return underlying.for_each_while([&](auto &&content) {
+      return sink(OutputType<Enumerate<I>>(i++, std::forward<decltype(content)>(content)));
+    });
+  }
+
  private:
   I underlying;
   size_t i;
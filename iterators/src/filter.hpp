@@ -2,11 +2,23 @@
 
 #include "../inc/interface.hpp"
 
+#include "kernels/inc/kernels.hpp"
+
 namespace colex::iterator {
 
 template<typename F, typename I>
 class Filter : public Iterator<Filter<F, I>> {
  public:
+  /**
+   * True if the predicate can be evaluated on the underlying items in
+   * place, with the survivors packed by the compress kernel
+   */
+  static constexpr bool compresses =
+          is_contiguous_v<I> && kernel::has_kernels_v<OutputType<I>>
+          && std::is_invocable_r_v<bool, F &, const OutputType<I> &>;
+  static constexpr bool batched = is_batched_v<I> || compresses;
+  static constexpr bool sorted = is_sorted_v<I>;
+
   explicit Filter(F predicate, Iterator<I> &&underlying)
           : underlying(static_cast<I &&>(underlying)), predicate(predicate) {}
 
@@ -24,7 +36,76 @@ class Filter : public Iterator<Filter<F, I>> {
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    return {0, underlying.size_hint().upper};
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    return underlying.for_each_while([&](auto &&content) {
+      if (predicate(content)) {
+        return sink(std::forward<decltype(content)>(content));
+      }
+
+      return true;
+    });
+  }
+
+  size_t next_batch(OutputType<Filter<F, I>> *out, size_t max) {
+    if constexpr (compresses) {
+      return compress_batch(out, max);
+    } else if constexpr (batched) {
+      size_t n = 0;
+
+      while (n < max) {
+        size_t wanted = max - n;
+        size_t got = underlying.next_batch(out + n, wanted);
+
+        for (size_t k = n, end = n + got; k < end; ++k) {
+          if constexpr (std::is_trivially_copyable_v<OutputType<I>>) {
+            bool keep = predicate(out[k]);
+            out[n] = out[k];
+            n += keep;
+          } else if (predicate(out[k])) {
+            if (k != n) { out[n] = std::move(out[k]); }
+            ++n;
+          }
+        }
+
+        if (got < wanted) { break; }
+      }
+
+      return n;
+    } else {
+      return fill_batch(*this, out, max);
+    }
+  }
+
  private:
+  using Value = OutputType<I>;
+
+  /**
+   * Evaluates the predicate on a block of items into a mask, and
+   * then packs the items that passed into `out` without branching.
+   */
+  size_t compress_batch(Value *out, size_t max) {
+    std::array<bool, batch_size> keep;
+    size_t n = 0;
+
+    while (n < max) {
+      size_t count = std::min({max - n, keep.size(), underlying.size_hint().lower});
+      if (count == 0) { break; }
+
+      const Value *items = underlying.data();
+      for (size_t k = 0; k < count; ++k) { keep[k] = predicate(items[k]); }
+
+      n += kernel::compress(items, keep.data(), count, out + n);
+      underlying.advance(count);
+    }
+
+    return n;
+  }
+
   I underlying;
   F predicate;
 };
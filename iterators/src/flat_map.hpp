@@ -38,6 +38,33 @@ class FlatMap : public Iterator<FlatMap<F, I>> {
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    if (!m_inner.has_value()) { return SizeHint::exact(0); }
+
+    auto inner = m_inner.value().size_hint();
+    if (m_outer.size_hint().upper == 0) { return inner; }
+
+    return {inner.lower, {}};
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    if (!m_inner.has_value()) { return true; }
+    if (!m_inner.value().for_each_while(sink)) { return false; }
+
+    m_inner.reset();
+
+    // The inner iterators are constructed in place on the stack, and only
+    // moved into `m_inner` if the sink stops before one is exhausted
+    return m_outer.for_each_while([&](auto &&outer_content) {
+      auto inner = m_func(std::forward<decltype(outer_content)>(outer_content));
+      if (inner.for_each_while(sink)) { return true; }
+
+      m_inner.emplace(std::move(inner));
+      return false;
+    });
+  }
+
  private:
   I m_outer;
   std::optional<std::invoke_result_t<F, OutputType<I>>> m_inner;
@@ -38,6 +38,26 @@ class Flatten : public Iterator<Flatten<I>> {
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    if (!m_inner.has_value()) { return SizeHint::exact(0); }
+
+    auto inner = m_inner.value().size_hint();
+    if (m_outer.size_hint().upper == 0) { return inner; }
+
+    return {inner.lower, {}};
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    if (!m_inner.has_value()) { return true; }
+    if (!m_inner.value().for_each_while(sink)) { return false; }
+
+    return m_outer.for_each_while([&](auto &&outer_content) {
+      m_inner.emplace(std::forward<decltype(outer_content)>(outer_content));
+      return m_inner.value().for_each_while(sink);
+    });
+  }
+
  private:
   I m_outer;
   std::optional<OutputType<I>> m_inner;
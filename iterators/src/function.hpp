@@ -18,6 +18,17 @@ class Function : public Iterator<Function<F>> {
     return std::move(m_func());
   }
 
+  [[nodiscard]] SizeHint size_hint() const { return SizeHint::unknown(); }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    for (auto content = m_func(); content.has_value(); content = m_func()) {
+      if (!sink(std::move(content.value()))) { return false; }
+    }
+
+    return true;
+  }
+
  private:
   F m_func;
 };
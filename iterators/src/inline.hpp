@@ -0,0 +1,140 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+
+namespace colex::iterator {
+
+/**
+ * An iterator over at most `N` owned items, stored inside the iterator
+ * itself so that creating it never allocates. Items are destroyed as
+ * soon as they are moved out, so only the remaining ones are alive.
+ */
+template<typename T, size_t N>
+class Inline : public Iterator<Inline<T, N>> {
+  static_assert(N > 0, "Inline needs room for at least one item");
+
+ public:
+  static constexpr bool random_access = true;
+  static constexpr bool contiguous = true;
+
+  Inline() : m_begin(0), m_end(0) {}
+
+  /**
+   * Throws `std::length_error` if there are more than `N` items
+   */
+  Inline(std::initializer_list<T> xs) : Inline() {
+    if (xs.size() > N) { throw std::length_error("Inline: too many items"); }
+
+    for (const T &x : xs) { ::new(raw(m_end++)) T(x); }
+  }
+
+  Inline(const Inline &) = delete;
+  Inline &operator=(const Inline &) = delete;
+
+  Inline(Inline &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+          : Inline() {
+    take(other);
+  }
+
+  Inline &operator=(Inline &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      destroy(m_begin, m_end);
+      m_begin = m_end = 0;
+      take(other);
+    }
+
+    return *this;
+  }
+
+  ~Inline() { destroy(m_begin, m_end); }
+
+  /**
+   * Adds an item at the end.
+   * Throws `std::length_error` if `N` items were added already
+   */
+  void push_back(T x) {
+    if (m_end == N) { throw std::length_error("Inline: too many items"); }
+
+    ::new(raw(m_end++)) T(std::move(x));
+  }
+
+  [[nodiscard]] std::optional<OutputType<Inline<T, N>>> next() {
+    if (m_begin == m_end) { return {}; }
+
+    std::optional<T> content(std::move(*slot(m_begin)));
+    destroy(m_begin, m_begin + 1);
+    ++m_begin;
+
+    return content;
+  }
+
+  [[nodiscard]] SizeHint size_hint() const { return SizeHint::exact(m_end - m_begin); }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    while (m_begin < m_end) {
+      T *x = slot(m_begin++);
+      bool more = sink(std::move(*x));
+      x->~T();
+
+      if (!more) { return false; }
+    }
+
+    return true;
+  }
+
+  void advance(size_t n) {
+    size_t k = std::min(n, m_end - m_begin);
+    destroy(m_begin, m_begin + k);
+    m_begin += k;
+  }
+
+  void truncate(size_t n) {
+    size_t end = m_begin + std::min(n, m_end - m_begin);
+    destroy(end, m_end);
+    m_end = end;
+  }
+
+  [[nodiscard]] const T *data() const {
+    return m_begin < m_end ? slot(m_begin) : nullptr;
+  }
+
+ private:
+  void *raw(size_t i) { return m_storage + i * sizeof(T); }
+
+  T *slot(size_t i) { return std::launder(reinterpret_cast<T *>(m_storage) + i); }
+
+  const T *slot(size_t i) const {
+    return std::launder(reinterpret_cast<const T *>(m_storage) + i);
+  }
+
+  void destroy(size_t begin, size_t end) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t i = begin; i < end; ++i) { slot(i)->~T(); }
+    }
+  }
+
+  /**
+   * Moves the remaining items of `other` to the front of this empty iterator
+   */
+  void take(Inline &other) {
+    for (size_t i = other.m_begin; i < other.m_end; ++i) {
+      ::new(raw(m_end++)) T(std::move(*other.slot(i)));
+    }
+  }
+
+  size_t m_begin;
+  size_t m_end;
+  alignas(T) unsigned char m_storage[N * sizeof(T)];
+};
+
+template<typename T, size_t N>
+struct Types<Inline<T, N>> {
+  using Output = T;
+};
+
+}
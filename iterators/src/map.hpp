@@ -7,6 +7,9 @@ namespace colex::iterator {
 template<typename F, typename I>
 class Map : public Iterator<Map<F, I>> {
  public:
+  static constexpr bool batched =
+          is_batched_v<I> && is_batchable_v<OutputType<I>>;
+
   explicit Map(F func, Iterator<I> &&underlying)
           : underlying(static_cast<I &&>(underlying)), func(func) {}
 
@@ -23,6 +26,38 @@ class Map : public Iterator<Map<F, I>> {
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const { return underlying.size_hint(); }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    return underlying.for_each_while([&](auto &&content) {
+      return sink(func(std::forward<decltype(content)>(content)));
+    });
+  }
+
+  size_t next_batch(OutputType<Map<F, I>> *out, size_t max) {
+    if constexpr (batched) {
+      std::array<OutputType<I>, batch_size> buffer;
+      size_t n = 0;
+
+      while (n < max) {
+        size_t wanted = std::min(max - n, buffer.size());
+        size_t got = underlying.next_batch(buffer.data(), wanted);
+
+        for (size_t k = 0; k < got; ++k) {
+          out[n + k] = func(std::move(buffer[k]));
+        }
+
+        n += got;
+        if (got < wanted) { break; }
+      }
+
+      return n;
+    } else {
+      return fill_batch(*this, out, max);
+    }
+  }
+
  private:
   I underlying;
   F func;
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+namespace colex::iterator {
+
+/**
+ * A map followed by a filter on the mapped values, in a single stage
+ */
+template<typename F, typename P, typename I>
+class MapFilter : public Iterator<MapFilter<F, P, I>> {
+ public:
+  static constexpr bool batched =
+          is_batched_v<I> && is_batchable_v<OutputType<I>>;
+
+  explicit MapFilter(F func, P predicate, Iterator<I> &&underlying)
+          : m_underlying(static_cast<I &&>(underlying)), m_func(std::move(func)),
+            m_predicate(std::move(predicate)) {}
+
+  MapFilter(const MapFilter &) = delete;
+  MapFilter(MapFilter &&) noexcept = default;
+  MapFilter &operator=(MapFilter &&) noexcept = default;
+  MapFilter &operator=(const MapFilter &) = delete;
+
+  [[nodiscard]] std::optional<OutputType<MapFilter<F, P, I>>> next() {
+    for (auto content = m_underlying.next(); content.has_value();
+         content = m_underlying.next()) {
+      auto mapped = m_func(std::move(content.value()));
+      if (m_predicate(mapped)) { return std::move(mapped); }
+    }
+
+    return {};
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    return {0, m_underlying.size_hint().upper};
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    return m_underlying.for_each_while([&](auto &&content) {
+      auto mapped = m_func(std::forward<decltype(content)>(content));
+      if (m_predicate(mapped)) { return sink(std::move(mapped)); }
+
+      return true;
+    });
+  }
+
+  size_t next_batch(OutputType<MapFilter<F, P, I>> *out, size_t max) {
+    if constexpr (batched) {
+      std::array<OutputType<I>, batch_size> buffer;
+      size_t n = 0;
+
+      while (n < max) {
+        size_t wanted = std::min(max - n, buffer.size());
+        size_t got = m_underlying.next_batch(buffer.data(), wanted);
+
+        for (size_t k = 0; k < got; ++k) {
+          auto mapped = m_func(std::move(buffer[k]));
+          if (m_predicate(mapped)) { out[n++] = std::move(mapped); }
+        }
+
+        if (got < wanted) { break; }
+      }
+
+      return n;
+    } else {
+      return fill_batch(*this, out, max);
+    }
+  }
+
+ private:
+  I m_underlying;
+  F m_func;
+  P m_predicate;
+};
+
+template<typename F, typename P, typename I>
+struct Types<MapFilter<F, P, I>> {
+  using Output = std::invoke_result_t<F, OutputType<I>>;
+};
+
+}
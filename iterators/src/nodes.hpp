@@ -0,0 +1,245 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace colex::iterator {
+
+/**
+ * True if `T` is the node handle of a map, i.e. the
+ * `node_type` of `std::map`, `std::unordered_map` and friends
+ */
+template<typename T, typename = void>
+struct IsMapNode : std::false_type {};
+
+template<typename T>
+struct IsMapNode<T, std::void_t<decltype(std::declval<const T &>().get_allocator()),
+                                decltype(std::declval<T &>().key()),
+                                decltype(std::declval<T &>().mapped())>>
+        : std::true_type {};
+
+template<typename T>
+constexpr bool is_map_node_v = IsMapNode<T>::value;
+
+/**
+ * True if `T` is the node handle of a set, i.e. the
+ * `node_type` of `std::set`, `std::unordered_set` and friends
+ */
+template<typename T, typename = void>
+struct IsSetNode : std::false_type {};
+
+template<typename T>
+struct IsSetNode<T, std::void_t<decltype(std::declval<const T &>().get_allocator()),
+                                decltype(std::declval<T &>().value())>>
+        : std::true_type {};
+
+template<typename T>
+constexpr bool is_set_node_v = IsSetNode<T>::value;
+
+/**
+ * True if `T` is the node handle type of the container `C`
+ */
+template<typename T, typename C, typename = void>
+struct IsNodeOf : std::false_type {};
+
+template<typename T, typename C>
+struct IsNodeOf<T, C, std::void_t<typename C::node_type>>
+        : std::is_same<T, typename C::node_type> {};
+
+template<typename T, typename C>
+constexpr bool is_node_of_v = IsNodeOf<T, C>::value;
+
+/**
+ * The value a set collects from items of type `T`.
+ * Node handles contribute the value they own.
+ */
+template<typename T, typename = void>
+struct SetElement {
+  using Type = T;
+};
+
+template<typename T>
+struct SetElement<T, std::enable_if_t<is_set_node_v<T>>> {
+  using Type = typename T::value_type;
+};
+
+/**
+ * The key and value a map collects from items of type `T`, which are
+ * either pairs or node handles.
+ */
+template<typename T, typename = void>
+struct MapElement {
+  using Key = typename T::first_type;
+  using Mapped = typename T::second_type;
+};
+
+template<typename T>
+struct MapElement<T, std::enable_if_t<is_map_node_v<T>>> {
+  using Key = typename T::key_type;
+  using Mapped = typename T::mapped_type;
+};
+
+template<typename I>
+using SetElementType = typename SetElement<OutputType<I>>::Type;
+
+template<typename I>
+using MapKeyType = typename MapElement<OutputType<I>>::Key;
+
+template<typename I>
+using MapValueType = typename MapElement<OutputType<I>>::Mapped;
+
+/**
+ * Inserts `content` into the set or map `container`. Node handles of
+ * the container's own node type are linked in without allocating, and
+ * other node handles have their contents moved out.
+ */
+template<typename C, typename T>
+void insert_element(C &container, T &&content) {
+  using U = std::remove_cv_t<std::remove_reference_t<T>>;
+
+  if constexpr (is_node_of_v<U, C>) {
+    container.insert(std::move(content));
+  } else if constexpr (is_map_node_v<U>) {
+    container.emplace(std::move(content.key()), std::move(content.mapped()));
+  } else if constexpr (is_set_node_v<U>) {
+    container.insert(std::move(content.value()));
+  } else {
+    container.insert(std::forward<T>(content));
+  }
+}
+
+/**
+ * Like `insert_element`, but inserts `content` right before `hint`.
+ * Inserting sorted items at the end of an ordered container this way
+ * takes amortized constant time instead of a search from the root.
+ */
+template<typename C, typename T>
+void insert_element(C &container, typename C::const_iterator hint, T &&content) {
+  using U = std::remove_cv_t<std::remove_reference_t<T>>;
+
+  if constexpr (is_node_of_v<U, C>) {
+    container.insert(hint, std::move(content));
+  } else if constexpr (is_map_node_v<U>) {
+    container.emplace_hint(hint, std::move(content.key()), std::move(content.mapped()));
+  } else if constexpr (is_set_node_v<U>) {
+    container.emplace_hint(hint, std::move(content.value()));
+  } else {
+    container.emplace_hint(hint, std::forward<T>(content));
+  }
+}
+
+/**
+ * The items of an owned set or map. Maps yield pairs with a mutable key.
+ */
+template<typename C, typename = void>
+struct NodeElement {
+  using Type = typename C::value_type;
+};
+
+template<typename C>
+struct NodeElement<C, std::void_t<typename C::mapped_type>> {
+  using Type = std::pair<typename C::key_type, typename C::mapped_type>;
+};
+
+/**
+ * An iterator over an owned set or map. Each item is extracted
+ * from the container, so keys are moved out instead of copied.
+ */
+template<typename C>
+class NodeMove : public Iterator<NodeMove<C>> {
+ public:
+  static constexpr bool sorted = is_sorted_container_v<C>;
+
+  explicit NodeMove(C &&underlying) : m_underlying(std::move(underlying)) {}
+
+  NodeMove(const NodeMove &) = delete;
+  NodeMove(NodeMove &&) noexcept = default;
+  NodeMove &operator=(NodeMove &&) noexcept = default;
+  NodeMove &operator=(const NodeMove &) = delete;
+
+  [[nodiscard]] std::optional<OutputType<NodeMove<C>>> next() {
+    if (m_underlying.empty()) { return {}; }
+
+    return take(m_underlying.extract(m_underlying.begin()));
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    return SizeHint::exact(m_underlying.size());
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    while (!m_underlying.empty()) {
+      if (!sink(take(m_underlying.extract(m_underlying.begin())))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+ private:
+  static OutputType<NodeMove<C>> take(typename C::node_type &&node) {
+    if constexpr (is_map_node_v<typename C::node_type>) {
+      return {std::move(node.key()), std::move(node.mapped())};
+    } else {
+      return std::move(node.value());
+    }
+  }
+
+  C m_underlying;
+};
+
+template<typename C>
+struct Types<NodeMove<C>> {
+  using Output = typename NodeElement<C>::Type;
+};
+
+/**
+ * An iterator over the node handles of an owned set or map.
+ * Collecting the nodes into a container of the same kind
+ * relinks them without allocating.
+ */
+template<typename C>
+class Nodes : public Iterator<Nodes<C>> {
+ public:
+  static constexpr bool sorted = is_sorted_container_v<C>;
+
+  explicit Nodes(C &&underlying) : m_underlying(std::move(underlying)) {}
+
+  Nodes(const Nodes &) = delete;
+  Nodes(Nodes &&) noexcept = default;
+  Nodes &operator=(Nodes &&) noexcept = default;
+  Nodes &operator=(const Nodes &) = delete;
+
+  [[nodiscard]] std::optional<OutputType<Nodes<C>>> next() {
+    if (m_underlying.empty()) { return {}; }
+
+    return m_underlying.extract(m_underlying.begin());
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    return SizeHint::exact(m_underlying.size());
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    while (!m_underlying.empty()) {
+      if (!sink(m_underlying.extract(m_underlying.begin()))) { return false; }
+    }
+
+    return true;
+  }
+
+ private:
+  C m_underlying;
+};
+
+template<typename C>
+struct Types<Nodes<C>> {
+  using Output = typename C::node_type;
+};
+
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include "executors/inc/executors.hpp"
+
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace colex::iterator {
+
+/**
+ * The type of the chunks `ParChunkMap` hands to its workers.
+ * Splittable iterators are cut with `split`. Chunks of other
+ * iterators are moved into vectors on the calling thread.
+ */
+template<typename I>
+using ParChunkType = std::conditional_t<
+        is_splittable_v<I>, I, STLMove<std::vector, OutputType<I>>>;
+
+/**
+ * A chunk map where the expression is applied on a thread pool.
+ * Chunks are cut from the underlying iterator on the calling thread,
+ * at most `max_in_flight` of them are being processed at once, and
+ * results are yielded in chunk order.
+ */
+template<typename E, typename I>
+class ParChunkMap : public Iterator<ParChunkMap<E, I>> {
+ public:
+  explicit ParChunkMap(size_t size, E expr, executor::ThreadPool &pool,
+                       size_t max_in_flight, Iterator<I> &&underlying)
+          : m_underlying(static_cast<I &&>(underlying)), m_size(size),
+            m_expr(std::make_shared<const E>(std::move(expr))), m_pool(&pool),
+            m_max_in_flight(std::max<size_t>(1, max_in_flight)),
+            m_exhausted(size == 0) {}
+
+  ParChunkMap(const ParChunkMap &) = delete;
+  ParChunkMap(ParChunkMap &&) noexcept = default;
+  ParChunkMap &operator=(ParChunkMap &&) noexcept = default;
+  ParChunkMap &operator=(const ParChunkMap &) = delete;
+
+  /**
+   * Waits for chunks that are still being processed, since
+   * they may refer to things that die with the iterator.
+   */
+  ~ParChunkMap() {
+    for (auto &chunk : m_in_flight) {
+      if (chunk.valid()) { m_pool->wait(chunk); }
+    }
+  }
+
+  [[nodiscard]] std::optional<OutputType<ParChunkMap<E, I>>> next() {
+    submit_chunks();
+
+    if (m_in_flight.empty()) { return {}; }
+
+    auto chunk = std::move(m_in_flight.front());
+    m_in_flight.pop_front();
+    m_pool->wait(chunk);
+
+    submit_chunks();
+    return chunk.get();
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    // Chunks of size 0 are never produced
+    if (m_size == 0) { return SizeHint::exact(m_in_flight.size()); }
+
+    auto hint = m_exhausted ? SizeHint::exact(0) : m_underlying.size_hint();
+    auto chunks = [this](size_t n) { return n / m_size + (n % m_size != 0); };
+
+    if (hint.upper.has_value()) {
+      return SizeHint::exact(m_in_flight.size())
+             + SizeHint{chunks(hint.lower), chunks(hint.upper.value())};
+    }
+
+    return SizeHint::exact(m_in_flight.size()) + SizeHint{chunks(hint.lower), {}};
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    for (;;) {
+      auto content = next();
+
+      if (!content.has_value()) { return true; }
+      if (!sink(std::move(content.value()))) { return false; }
+    }
+  }
+
+ private:
+  using Input = OutputType<I>;
+  using Output = OutputType<ParChunkMap<E, I>>;
+
+  /**
+   * Cuts the next chunk off the underlying iterator
+   */
+  std::optional<ParChunkType<I>> next_chunk() {
+    if constexpr (is_splittable_v<I>) {
+      if (m_underlying.size_hint().lower == 0) { return {}; }
+
+      return m_underlying.split(m_size);
+    } else {
+      std::vector<Input> chunk;
+      chunk.reserve(m_size);
+
+      m_underlying.for_each_while([&](auto &&content) {
+        chunk.push_back(std::forward<decltype(content)>(content));
+        return chunk.size() < m_size;
+      });
+
+      if (chunk.empty()) { return {}; }
+
+      return ParChunkType<I>(std::move(chunk));
+    }
+  }
+
+  /**
+   * Cuts chunks off the underlying iterator until the pipeline is full
+   */
+  void submit_chunks() {
+    while (!m_exhausted && m_in_flight.size() < m_max_in_flight) {
+      auto chunk = next_chunk();
+
+      if (!chunk.has_value()) {
+        m_exhausted = true;
+        return;
+      }
+
+      m_in_flight.push_back(m_pool->submit(
+              [expr = m_expr, chunk = std::move(chunk.value())]() mutable {
+                return expr->apply(std::move(chunk));
+              }));
+    }
+  }
+
+  I m_underlying;
+  size_t m_size;
+  std::shared_ptr<const E> m_expr;
+  executor::ThreadPool *m_pool;
+  size_t m_max_in_flight;
+  std::deque<std::future<Output>> m_in_flight;
+  bool m_exhausted;
+};
+
+template<typename E, typename I>
+struct Types<ParChunkMap<E, I>> {
+  using Output = expression::OutputType<E, ParChunkType<I>>;
+};
+
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include "executors/inc/executors.hpp"
+
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace colex::iterator {
+
+/**
+ * A map where the function is evaluated on a thread pool.
+ * Items are pulled from the underlying iterator on the calling
+ * thread in morsels of `morsel_size` items, and each morsel is mapped
+ * by a worker. At most two morsels per worker are in flight at once,
+ * and results are yielded in input order.
+ */
+template<typename F, typename I>
+class ParMap : public Iterator<ParMap<F, I>> {
+ public:
+  explicit ParMap(F func, executor::ThreadPool &pool, size_t morsel_size,
+                  Iterator<I> &&underlying)
+          : m_underlying(static_cast<I &&>(underlying)),
+            m_func(std::make_shared<const F>(std::move(func))), m_pool(&pool),
+            m_morsel_size(std::max<size_t>(1, morsel_size)),
+            m_max_in_flight(2 * pool.thread_count()), m_in_flight_items(0),
+            m_position(0), m_exhausted(false) {}
+
+  ParMap(const ParMap &) = delete;
+  ParMap(ParMap &&) noexcept = default;
+  ParMap &operator=(ParMap &&) noexcept = default;
+  ParMap &operator=(const ParMap &) = delete;
+
+  /**
+   * Waits for morsels that are still being mapped, since
+   * they may refer to things that die with the iterator.
+   */
+  ~ParMap() {
+    for (auto &morsel : m_in_flight) {
+      if (morsel.valid()) { m_pool->wait(morsel); }
+    }
+  }
+
+  [[nodiscard]] std::optional<OutputType<ParMap<F, I>>> next() {
+    if (m_position == m_current.size() && !refill()) { return {}; }
+
+    return std::move(m_current[m_position++]);
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    size_t buffered = m_current.size() - m_position + m_in_flight_items;
+    return SizeHint::exact(buffered) + m_underlying.size_hint();
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    for (;;) {
+      while (m_position < m_current.size()) {
+        if (!sink(std::move(m_current[m_position++]))) { return false; }
+      }
+
+      if (!refill()) { return true; }
+    }
+  }
+
+ private:
+  using Input = OutputType<I>;
+  using Output = OutputType<ParMap<F, I>>;
+
+  /**
+   * Replaces the current results with those of the oldest morsel.
+   * Returns false if there are no more morsels.
+   */
+  bool refill() {
+    submit_morsels();
+
+    if (m_in_flight.empty()) { return false; }
+
+    auto morsel = std::move(m_in_flight.front());
+    m_in_flight.pop_front();
+    m_pool->wait(morsel);
+
+    m_current = morsel.get();
+    m_position = 0;
+    m_in_flight_items -= m_current.size();
+
+    submit_morsels();
+    return true;
+  }
+
+  /**
+   * Pulls morsels from the underlying iterator until the pipeline is full
+   */
+  void submit_morsels() {
+    while (!m_exhausted && m_in_flight.size() < m_max_in_flight) {
+      std::vector<Input> morsel;
+      morsel.reserve(m_morsel_size);
+
+      m_exhausted = m_underlying.for_each_while([&](auto &&content) {
+        morsel.push_back(std::forward<decltype(content)>(content));
+        return morsel.size() < m_morsel_size;
+      });
+
+      if (morsel.empty()) { return; }
+
+      m_in_flight_items += morsel.size();
+      m_in_flight.push_back(m_pool->submit(
+              [func = m_func, morsel = std::move(morsel)]() mutable {
+                std::vector<Output> results;
+                results.reserve(morsel.size());
+
+                for (auto &content : morsel) {
+                  results.push_back((*func)(std::move(content)));
+                }
+
+                return results;
+              }));
+    }
+  }
+
+  I m_underlying;
+  std::shared_ptr<const F> m_func;
+  executor::ThreadPool *m_pool;
+  size_t m_morsel_size;
+  size_t m_max_in_flight;
+  std::deque<std::future<std::vector<Output>>> m_in_flight;
+  size_t m_in_flight_items;
+  std::vector<Output> m_current;
+  size_t m_position;
+  bool m_exhausted;
+};
+
+template<typename F, typename I>
+struct Types<ParMap<F, I>> {
+  using Output = std::invoke_result_t<const F &, OutputType<I>>;
+};
+
+}
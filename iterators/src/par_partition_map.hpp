@@ -0,0 +1,187 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+#include "partition.hpp"
+
+#include "executors/inc/executors.hpp"
+
+#include <deque>
+#include <future>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace colex::iterator {
+
+/**
+ * A partition map where the expression is applied to each partition
+ * on a thread pool, and results are yielded in partition order.
+ *
+ * Splittable iterators are cut at the prefix sums of the partition
+ * sizes, and all partitions are submitted at once, so idle workers
+ * steal partitions from busy ones no matter how uneven they are.
+ * Partitions of other iterators are moved into vectors on the calling
+ * thread, with at most two partitions per worker in flight.
+ */
+template<typename E, typename I>
+class ParPartitionMap : public Iterator<ParPartitionMap<E, I>> {
+ public:
+  explicit ParPartitionMap(PartitionSizes partition_sizes,
+                           E expr, executor::ThreadPool &pool, Iterator<I> &&underlying)
+          : m_underlying(static_cast<I &&>(underlying)),
+            m_partition_sizes(std::move(partition_sizes)), m_partition_index(0),
+            m_expr(std::make_shared<const E>(std::move(expr))), m_pool(&pool),
+            m_max_in_flight(2 * pool.thread_count()),
+            m_exhausted(false) {}
+
+  ParPartitionMap(const ParPartitionMap &) = delete;
+  ParPartitionMap(ParPartitionMap &&) noexcept = default;
+  ParPartitionMap &operator=(ParPartitionMap &&) noexcept = default;
+  ParPartitionMap &operator=(const ParPartitionMap &) = delete;
+
+  /**
+   * Waits for partitions that are still being processed, since
+   * they may refer to things that die with the iterator.
+   */
+  ~ParPartitionMap() {
+    for (auto &partition : m_in_flight) {
+      if (partition.valid()) { m_pool->wait(partition); }
+    }
+  }
+
+  [[nodiscard]] std::optional<OutputType<ParPartitionMap<E, I>>> next() {
+    submit_partitions();
+
+    if (m_in_flight.empty()) { return {}; }
+
+    auto partition = std::move(m_in_flight.front());
+    m_in_flight.pop_front();
+    m_pool->wait(partition);
+
+    submit_partitions();
+    return partition.get();
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    if (m_exhausted) { return SizeHint::exact(m_in_flight.size()); }
+
+    return SizeHint::exact(m_in_flight.size())
+           + partitions_left(m_partition_sizes, m_partition_index, m_underlying.size_hint());
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    for (;;) {
+      auto content = next();
+
+      if (!content.has_value()) { return true; }
+      if (!sink(std::move(content.value()))) { return false; }
+    }
+  }
+
+ private:
+  using Input = OutputType<I>;
+  using Output = OutputType<ParPartitionMap<E, I>>;
+
+  /**
+   * The offsets at which each of the remaining partitions ends,
+   * relative to the next item, capped at the number of items left.
+   * The last partition takes whatever is left after the given sizes.
+   */
+  std::vector<size_t> partition_ends() const {
+    size_t remaining = m_underlying.size_hint().lower;
+    std::vector<size_t> ends;
+    ends.reserve(m_partition_sizes->size() - m_partition_index + 1);
+
+    size_t end = 0;
+    for (size_t i = m_partition_index; i < m_partition_sizes->size(); ++i) {
+      end = std::min(remaining, saturating_add(end, (*m_partition_sizes)[i]));
+      ends.push_back(end);
+    }
+    ends.push_back(remaining);
+
+    return ends;
+  }
+
+  /**
+   * Cuts the next partition off the underlying iterator
+   */
+  std::optional<ParChunkType<I>> next_partition(size_t n) {
+    if constexpr (is_splittable_v<I>) {
+      if (n == 0) { return {}; }
+
+      return m_underlying.split(n);
+    } else {
+      std::vector<Input> partition;
+
+      if (n > 0) {
+        m_underlying.for_each_while([&](auto &&content) {
+          partition.push_back(std::forward<decltype(content)>(content));
+          return partition.size() < n;
+        });
+      }
+
+      if (partition.empty()) { return {}; }
+
+      return ParChunkType<I>(std::move(partition));
+    }
+  }
+
+  void submit(ParChunkType<I> partition) {
+    m_in_flight.push_back(m_pool->submit(
+            [expr = m_expr, partition = std::move(partition)]() mutable {
+              return expr->apply(std::move(partition));
+            }));
+  }
+
+  /**
+   * Submits partitions until the pipeline is full. Like `partition_map`,
+   * the first empty partition ends the iteration.
+   */
+  void submit_partitions() {
+    if (m_exhausted) { return; }
+
+    if constexpr (is_splittable_v<I>) {
+      size_t begin = 0;
+      for (size_t end : partition_ends()) {
+        auto partition = next_partition(end - begin);
+        if (!partition.has_value()) { break; }
+
+        submit(std::move(partition.value()));
+        begin = end;
+      }
+
+      m_exhausted = true;
+    } else {
+      while (m_in_flight.size() < m_max_in_flight) {
+        size_t n = m_partition_index == m_partition_sizes->size()
+                   ? std::numeric_limits<size_t>::max()
+                   : (*m_partition_sizes)[m_partition_index++];
+
+        auto partition = next_partition(n);
+        if (!partition.has_value()) {
+          m_exhausted = true;
+          return;
+        }
+
+        submit(std::move(partition.value()));
+      }
+    }
+  }
+
+  I m_underlying;
+  PartitionSizes m_partition_sizes;
+  size_t m_partition_index;
+  std::shared_ptr<const E> m_expr;
+  executor::ThreadPool *m_pool;
+  size_t m_max_in_flight;
+  std::deque<std::future<Output>> m_in_flight;
+  bool m_exhausted;
+};
+
+template<typename E, typename I>
+struct Types<ParPartitionMap<E, I>> {
+  using Output = expression::OutputType<E, ParChunkType<I>>;
+};
+
+}
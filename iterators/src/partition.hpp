@@ -1,16 +1,48 @@
 #pragma once
 
 #include "../inc/interface.hpp"
+#include "resource.hpp"
 
-#include <vector>
+#include <cstddef>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <vector>
 
 namespace colex::iterator {
 
+/**
+ * Partition sizes shared by a partition expression and its iterators
+ */
+using PartitionSizes = std::shared_ptr<const std::pmr::vector<size_t>>;
+
+/**
+ * Copies `sizes` into memory from the current resource. The allocator
+ * passes the resource on to the vector it constructs.
+ */
+inline PartitionSizes make_partition_sizes(const std::vector<size_t> &sizes) {
+  std::pmr::polymorphic_allocator<std::byte> allocator(current_resource());
+
+  return std::allocate_shared<std::pmr::vector<size_t>>(allocator, sizes.begin(), sizes.end());
+}
+
+/**
+ * Bounds on the number of partitions left when the next one is
+ * `sizes[index]` and `items` are left. A partition of size 0 ends
+ * the iteration, so there may be none even if items are left.
+ */
+inline SizeHint partitions_left(const PartitionSizes &sizes, size_t index, SizeHint items) {
+  bool next_empty = index < sizes->size() && (*sizes)[index] == 0;
+  size_t lower = items.lower > 0 && !next_empty ? 1 : 0;
+
+  return clamp({lower, items.upper}, sizes->size() - index + 1);
+}
+
 template<typename I>
 class Partition : public Iterator<Partition<I>> {
  public:
-  Partition(std::vector<size_t> partition_sizes, Iterator<I> &&underlying)
+  Partition(PartitionSizes partition_sizes,
+            Iterator<I> &&underlying)
           : m_partition_index(0), m_partition_sizes(std::move(partition_sizes)),
             m_underlying(static_cast<I &&>(underlying)) {}
 
@@ -20,29 +52,36 @@ class Partition : public Iterator<Partition<I>> {
   Partition &operator=(const Partition &) = delete;
 
   [[nodiscard]] std::optional<OutputType<Partition<I>>> next() {
-    size_t n = m_partition_index == m_partition_sizes.size()
+    size_t n = m_partition_index == m_partition_sizes->size()
                ? std::numeric_limits<size_t>::max()
-               : m_partition_sizes[m_partition_index++];
+               : (*m_partition_sizes)[m_partition_index++];
 
-    auto it = TakeRef<I>(n, m_underlying);
-    auto first = it.next();
-    if (first.has_value()) {
-      return Concat(ArrayMove(std::array{std::move(first.value())}),
-                    std::move(it));
-    }
+    return next_chunk(m_underlying, n);
+  }
 
-    return {};
+  [[nodiscard]] SizeHint size_hint() const {
+    return partitions_left(m_partition_sizes, m_partition_index, m_underlying.size_hint());
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    for (;;) {
+      auto content = next();
+
+      if (!content.has_value()) { return true; }
+      if (!sink(std::move(content.value()))) { return false; }
+    }
   }
 
  private:
   size_t m_partition_index;
-  std::vector<size_t> m_partition_sizes;
+  PartitionSizes m_partition_sizes;
   I m_underlying;
 };
 
 template<typename I>
 struct Types<Partition<I>> {
-  using Output = Concat<ArrayMove<OutputType<I>, 1>, TakeRef<I>>;
+  using Output = ChunkType<I>;
 };
 
 }
@@ -1,13 +1,19 @@
 #pragma once
 
 #include "../inc/interface.hpp"
+#include "partition.hpp"
+
+#include <limits>
+#include <memory>
+#include <vector>
 
 namespace colex::iterator {
 
 template<typename E, typename I>
 class PartitionMap : public Iterator<PartitionMap<E, I>> {
  public:
-  explicit PartitionMap(std::vector<size_t> partition_sizes, E expr, Iterator<I> &&iter)
+  explicit PartitionMap(PartitionSizes partition_sizes,
+                        E expr, Iterator<I> &&iter)
           : m_underlying(static_cast<I &&>(iter)),
             m_partition_sizes(std::move(partition_sizes)), m_partition_index(0),
             expr(std::move(expr)) {}
@@ -18,31 +24,40 @@ class PartitionMap : public Iterator<PartitionMap<E, I>> {
   PartitionMap &operator=(const PartitionMap &) = delete;
 
   [[nodiscard]] std::optional<OutputType<PartitionMap<E, I>>> next() {
-    size_t n = m_partition_index == m_partition_sizes.size()
+    size_t n = m_partition_index == m_partition_sizes->size()
                ? std::numeric_limits<size_t>::max()
-               : m_partition_sizes[m_partition_index++];
+               : (*m_partition_sizes)[m_partition_index++];
 
-    auto it = TakeRef<I>(n, m_underlying);
-    auto first = it.next();
-    if (first.has_value()) {
-      return expr.apply(Concat(ArrayMove(std::array{std::move(first.value())}),
-                               std::move(it)));
-    }
+    auto partition = next_chunk(m_underlying, n);
+    if (partition.has_value()) { return expr.apply(std::move(partition.value())); }
 
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    return partitions_left(m_partition_sizes, m_partition_index, m_underlying.size_hint());
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    for (;;) {
+      auto content = next();
+
+      if (!content.has_value()) { return true; }
+      if (!sink(std::move(content.value()))) { return false; }
+    }
+  }
+
  private:
   I m_underlying;
-  std::vector<size_t> m_partition_sizes;
+  PartitionSizes m_partition_sizes;
   size_t m_partition_index;
   E expr;
 };
 
 template<typename E, typename I>
 struct Types<PartitionMap<E, I>> {
-  using Output = expression::OutputType<
-  E, Concat<ArrayMove<OutputType<I>, 1>, TakeRef<I>>>;
+  using Output = expression::OutputType<E, ChunkType<I>>;
 };
 
 }
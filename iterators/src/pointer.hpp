@@ -7,6 +7,11 @@ namespace colex::iterator {
 template<typename T>
 class Pointer : public Iterator<Pointer<T>> {
  public:
+  static constexpr bool batched = true;
+  static constexpr bool random_access = true;
+  static constexpr bool splittable = true;
+  static constexpr bool contiguous = true;
+
   explicit Pointer(const T *underlying, size_t element_count)
           : m_ptr(underlying), m_end(m_ptr + element_count) {}
 
@@ -21,6 +26,52 @@ class Pointer : public Iterator<Pointer<T>> {
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    return SizeHint::exact(m_end - m_ptr);
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    const T *ptr = m_ptr;
+    const T *end = m_end;
+
+    while (ptr != end) {
+      if (!sink(T(*(ptr++)))) {
+        m_ptr = ptr;
+        return false;
+      }
+    }
+
+    m_ptr = ptr;
+    return true;
+  }
+
+  size_t next_batch(T *out, size_t max) {
+    size_t n = std::min(max, static_cast<size_t>(m_end - m_ptr));
+    std::copy(m_ptr, m_ptr + n, out);
+    m_ptr += n;
+
+    return n;
+  }
+
+  void advance(size_t n) {
+    m_ptr += std::min(n, static_cast<size_t>(m_end - m_ptr));
+  }
+
+  void truncate(size_t n) {
+    m_end = m_ptr + std::min(n, static_cast<size_t>(m_end - m_ptr));
+  }
+
+  [[nodiscard]] const T *data() const { return m_ptr; }
+
+  Pointer split(size_t n) {
+    size_t k = std::min(n, static_cast<size_t>(m_end - m_ptr));
+    Pointer front(m_ptr, k);
+    m_ptr += k;
+
+    return front;
+  }
+
  private:
   const T *m_ptr;
   const T *m_end;
@@ -34,6 +85,11 @@ struct Types<Pointer<T>> {
 template<typename T>
 class PointerMove : public Iterator<PointerMove<T>> {
  public:
+  static constexpr bool batched = true;
+  static constexpr bool random_access = true;
+  static constexpr bool splittable = true;
+  static constexpr bool contiguous = true;
+
   explicit PointerMove(T *underlying, size_t element_count)
           : m_ptr(underlying), m_end(m_ptr + element_count) {}
 
@@ -48,6 +104,52 @@ class PointerMove : public Iterator<PointerMove<T>> {
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    return SizeHint::exact(m_end - m_ptr);
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    T *ptr = m_ptr;
+    T *end = m_end;
+
+    while (ptr != end) {
+      if (!sink(std::move(*(ptr++)))) {
+        m_ptr = ptr;
+        return false;
+      }
+    }
+
+    m_ptr = ptr;
+    return true;
+  }
+
+  size_t next_batch(T *out, size_t max) {
+    size_t n = std::min(max, static_cast<size_t>(m_end - m_ptr));
+    std::move(m_ptr, m_ptr + n, out);
+    m_ptr += n;
+
+    return n;
+  }
+
+  void advance(size_t n) {
+    m_ptr += std::min(n, static_cast<size_t>(m_end - m_ptr));
+  }
+
+  void truncate(size_t n) {
+    m_end = m_ptr + std::min(n, static_cast<size_t>(m_end - m_ptr));
+  }
+
+  [[nodiscard]] const T *data() const { return m_ptr; }
+
+  PointerMove split(size_t n) {
+    size_t k = std::min(n, static_cast<size_t>(m_end - m_ptr));
+    PointerMove front(m_ptr, k);
+    m_ptr += k;
+
+    return front;
+  }
+
  private:
   T *m_ptr;
   T *m_end;
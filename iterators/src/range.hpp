@@ -2,12 +2,27 @@
 
 #include "../inc/interface.hpp"
 
+#include <type_traits>
+
 namespace colex::iterator {
 
+/**
+ * An iterator over `begin`, `begin + step`, ... up to but not including
+ * `end`. Integer ranges count their remaining items, so their length
+ * is known in constant time and stepping never overflows past `end`.
+ * An integer range whose step doesn't move from `begin` towards `end`
+ * never reaches it, so it is endless, like an `OpenRange`.
+ */
 template<typename T>
 class Range : public Iterator<Range<T>> {
  public:
-  explicit Range(T begin, T end, T step) : i(begin), end(end), step(step) {}
+  static constexpr bool batched = std::is_integral_v<T>;
+  static constexpr bool random_access = std::is_integral_v<T>;
+  static constexpr bool splittable = std::is_integral_v<T>;
+
+  explicit Range(T begin, T end, T step)
+          : i(begin), end(end), step(step), m_remaining(length(begin, end, step)),
+            m_endless(std::is_integral_v<T> && begin < end && !(T(0) < step)) {}
 
   Range(const Range &) = delete;
   Range(Range &&) noexcept = default;
@@ -15,20 +30,170 @@ class Range : public Iterator<Range<T>> {
   Range &operator=(const Range &) = delete;
 
   [[nodiscard]] std::optional<OutputType<Range>> next() {
-    if (i < end) {
+    if constexpr (std::is_integral_v<T>) {
+      if (m_endless) {
+        T value = i;
+        i = T(Unsigned(i) + Unsigned(step));
+
+        return value;
+      }
+
+      if (m_remaining == 0) { return {}; }
+
       T value = i;
-      i += step;
+      i = T(Unsigned(i) + Unsigned(step));
+      --m_remaining;
 
       return value;
+    } else {
+      if (i < end) {
+        T value = i;
+        i += step;
+
+        return value;
+      }
+
+      return {};
+    }
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    if constexpr (std::is_integral_v<T>) {
+      return m_endless ? SizeHint::infinite() : SizeHint::exact(m_remaining);
+    } else {
+      return SizeHint::unknown();
+    }
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    if constexpr (std::is_integral_v<T>) {
+      if (m_endless) {
+        for (;;) {
+          T current = i;
+          i = T(Unsigned(i) + Unsigned(step));
+
+          if (!sink(std::move(current))) { return false; }
+        }
+      }
+
+      Unsigned value = Unsigned(i);
+      size_t left = m_remaining;
+
+      while (left > 0) {
+        T current = T(value);
+        value += Unsigned(step);
+        --left;
+
+        if (!sink(std::move(current))) {
+          i = T(value);
+          m_remaining = left;
+          return false;
+        }
+      }
+
+      i = T(value);
+      m_remaining = 0;
+      return true;
+    } else {
+      T value = i;
+
+      while (value < end) {
+        T current = value;
+        value += step;
+
+        if (!sink(std::move(current))) {
+          i = value;
+          return false;
+        }
+      }
+
+      i = value;
+      return true;
+    }
+  }
+
+  size_t next_batch(T *out, size_t max) {
+    if constexpr (batched) {
+      size_t n = m_endless ? max : std::min(max, m_remaining);
+      Unsigned value = Unsigned(i);
+
+      for (size_t k = 0; k < n; ++k) {
+        out[k] = T(value);
+        value += Unsigned(step);
+      }
+
+      i = T(value);
+      if (!m_endless) { m_remaining -= n; }
+      return n;
+    } else {
+      return fill_batch(*this, out, max);
     }
+  }
+
+  void advance(size_t n) {
+    size_t k = m_endless ? n : std::min(n, m_remaining);
+    i = T(Unsigned(i) + Unsigned(k) * Unsigned(step));
+    if (!m_endless) { m_remaining -= k; }
+  }
+
+  void truncate(size_t n) {
+    if (m_endless || n < m_remaining) {
+      end = T(Unsigned(i) + Unsigned(n) * Unsigned(step));
+      m_remaining = n;
+      m_endless = false;
+    }
+  }
+
+  Range split(size_t n) {
+    Range front(i, end, step);
+    front.m_remaining = m_remaining;
+    front.m_endless = m_endless;
+    front.truncate(n);
+    advance(n);
+
+    return front;
+  }
+
+  /**
+   * The sum of the remaining items in closed form. Wraps around
+   * like adding them one by one in unsigned arithmetic would.
+   * The range must not be endless.
+   */
+  [[nodiscard]] T sum() const {
+    using W = std::common_type_t<Unsigned, unsigned>;
+
+    size_t n = m_remaining;
+    W pairs = n % 2 == 0 ? W(n / 2) * W(n - 1) : W(n) * W((n - 1) / 2);
 
-    return {};
+    return T(W(n) * W(Unsigned(i)) + pairs * W(Unsigned(step)));
   }
 
  private:
+  using Unsigned = typename std::conditional_t<std::is_integral_v<T>,
+                                               std::make_unsigned<T>,
+                                               std::common_type<T>>::type;
+
+  /**
+   * The number of items, or 0 if the range is empty or endless
+   */
+  static size_t length(T begin, T end, T step) {
+    if constexpr (std::is_integral_v<T>) {
+      if (!(begin < end) || !(T(0) < step)) { return 0; }
+
+      Unsigned distance = Unsigned(end) - Unsigned(begin);
+      Unsigned stride = Unsigned(step);
+      return size_t(distance / stride + (distance % stride != 0));
+    } else {
+      return 0;
+    }
+  }
+
   T i;
   T end;
   T step;
+  size_t m_remaining;
+  bool m_endless;
 };
 
 template<typename T>
@@ -54,6 +219,18 @@ class OpenRange : public Iterator<OpenRange<T>> {
     return value;
   }
 
+  [[nodiscard]] SizeHint size_hint() const { return SizeHint::infinite(); }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    for (;;) {
+      T value = i;
+      i += step;
+
+      if (!sink(std::move(value))) { return false; }
+    }
+  }
+
  private:
   T i;
   T step;
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include <functional>
+#include <iterator>
+
+namespace colex::iterator {
+
+/**
+ * An iterator over a borrowed range that yields references to
+ * the elements instead of copies of them
+ */
+template<typename It>
+class Ref : public Iterator<Ref<It>> {
+ public:
+  static constexpr bool random_access = is_random_access_iterator_v<It>;
+  static constexpr bool splittable = random_access;
+
+  explicit Ref(It begin, It end, size_t size)
+          : m_it(begin), m_end(end), m_remaining(size) {}
+
+  Ref(const Ref &) = delete;
+  Ref(Ref &&) noexcept = default;
+  Ref &operator=(Ref &&) noexcept = default;
+  Ref &operator=(const Ref &) = delete;
+
+  [[nodiscard]] std::optional<OutputType<Ref<It>>> next() {
+    if (m_it != m_end) {
+      --m_remaining;
+      return std::cref(*(m_it++));
+    }
+
+    return {};
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    return SizeHint::exact(m_remaining);
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    auto current = m_it;
+    size_t left = m_remaining;
+    bool exhausted = true;
+
+    while (current != m_end) {
+      --left;
+
+      if (!sink(std::cref(*(current++)))) {
+        exhausted = false;
+        break;
+      }
+    }
+
+    m_it = current;
+    m_remaining = left;
+    return exhausted;
+  }
+
+  void advance(size_t n) {
+    size_t k = std::min(n, m_remaining);
+    m_it += k;
+    m_remaining -= k;
+  }
+
+  void truncate(size_t n) {
+    if (n < m_remaining) {
+      m_end = m_it + n;
+      m_remaining = n;
+    }
+  }
+
+  Ref split(size_t n) {
+    size_t k = std::min(n, m_remaining);
+    Ref front(m_it, m_it + k, k);
+    advance(k);
+
+    return front;
+  }
+
+ private:
+  It m_it;
+  It m_end;
+  size_t m_remaining;
+};
+
+template<typename It>
+struct Types<Ref<It>> {
+  using Output = std::reference_wrapper<
+          const typename std::iterator_traits<It>::value_type>;
+};
+
+/**
+ * Turns an iterator over references into an iterator over copies
+ */
+template<typename I>
+class Copied : public Iterator<Copied<I>> {
+ public:
+  explicit Copied(Iterator<I> &&underlying)
+          : m_underlying(static_cast<I &&>(underlying)) {}
+
+  Copied(const Copied &) = delete;
+  Copied(Copied &&) noexcept = default;
+  Copied &operator=(Copied &&) noexcept = default;
+  Copied &operator=(const Copied &) = delete;
+
+  [[nodiscard]] std::optional<OutputType<Copied<I>>> next() {
+    auto content = m_underlying.next();
+
+    if (content.has_value()) { return content.value().get(); }
+
+    return {};
+  }
+
+  [[nodiscard]] SizeHint size_hint() const { return m_underlying.size_hint(); }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    return m_underlying.for_each_while([&](auto content) {
+      return sink(OutputType<Copied<I>>(content.get()));
+    });
+  }
+
+ private:
+  I m_underlying;
+};
+
+template<typename I>
+struct Types<Copied<I>> {
+  using Output = std::remove_cv_t<typename OutputType<I>::type>;
+};
+
+}
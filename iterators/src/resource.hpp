@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory_resource>
+
+namespace colex::iterator {
+
+/**
+ * The memory resource set by the innermost `ResourceScope` on this thread,
+ * or null if there is none
+ */
+inline thread_local std::pmr::memory_resource *scoped_resource = nullptr;
+
+/**
+ * The memory resource that pipeline stages allocate from on this thread
+ */
+inline std::pmr::memory_resource *current_resource() {
+  return scoped_resource != nullptr ? scoped_resource : std::pmr::get_default_resource();
+}
+
+/**
+ * Makes `resource` the current resource of this thread until destroyed
+ */
+class ResourceScope {
+ public:
+  explicit ResourceScope(std::pmr::memory_resource *resource)
+          : m_previous(scoped_resource) {
+    scoped_resource = resource;
+  }
+
+  ~ResourceScope() { scoped_resource = m_previous; }
+
+  ResourceScope(const ResourceScope &) = delete;
+  ResourceScope &operator=(const ResourceScope &) = delete;
+
+ private:
+  std::pmr::memory_resource *m_previous;
+};
+
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+#include <deque>
+#include <vector>
+
+namespace colex::iterator {
+
+/**
+ * The number of outputs of a rolling aggregate over `window` items
+ * that has seen `seen` items, when `remaining` items are left
+ */
+inline size_t rolling_outputs(size_t remaining, size_t seen, size_t window) {
+  size_t missing = seen < window - 1 ? window - 1 - seen : 0;
+  return remaining < missing ? 0 : remaining - missing;
+}
+
+/**
+ * The hint of a rolling aggregate, given the hint of its underlying iterator
+ */
+inline SizeHint rolling_hint(const SizeHint &underlying, size_t seen, size_t window) {
+  return {rolling_outputs(underlying.lower, seen, window),
+          underlying.upper.has_value()
+          ? std::optional<size_t>(rolling_outputs(underlying.upper.value(), seen, window))
+          : std::nullopt};
+}
+
+/**
+ * Yields the sum of each `window` consecutive items. Each step
+ * adds the new item and subtracts the one leaving the window.
+ */
+template<typename I>
+class RollingSum : public Iterator<RollingSum<I>> {
+ public:
+  explicit RollingSum(size_t window, Iterator<I> &&underlying)
+          : m_underlying(static_cast<I &&>(underlying)),
+            m_window(std::max<size_t>(1, window)), m_seen(0), m_oldest(0),
+            m_sum() {
+    m_items.reserve(m_window);
+  }
+
+  RollingSum(const RollingSum &) = delete;
+  RollingSum(RollingSum &&) noexcept = default;
+  RollingSum &operator=(RollingSum &&) noexcept = default;
+  RollingSum &operator=(const RollingSum &) = delete;
+
+  [[nodiscard]] std::optional<OutputType<RollingSum<I>>> next() {
+    if (!fill()) { return {}; }
+
+    auto content = m_underlying.next();
+    if (!content.has_value()) { return {}; }
+
+    return push(std::move(content.value()));
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    return rolling_hint(m_underlying.size_hint(), m_seen, m_window);
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    if (!fill()) { return true; }
+
+    return m_underlying.for_each_while([&](auto &&content) {
+      return sink(push(std::forward<decltype(content)>(content)));
+    });
+  }
+
+ private:
+  using Value = OutputType<I>;
+
+  /**
+   * Pulls all but the last item of the first window.
+   * Returns false if the underlying iterator ran out.
+   */
+  bool fill() {
+    if (m_seen + 1 >= m_window) { return true; }
+
+    m_underlying.for_each_while([&](auto &&content) {
+      push(std::forward<decltype(content)>(content));
+      return m_seen + 1 < m_window;
+    });
+
+    return m_seen + 1 >= m_window;
+  }
+
+  Value push(Value content) {
+    if (m_seen < m_window) {
+      m_sum = m_sum + content;
+      m_items.push_back(std::move(content));
+    } else {
+      m_sum = m_sum - m_items[m_oldest] + content;
+      m_items[m_oldest] = std::move(content);
+      m_oldest = m_oldest + 1 == m_window ? 0 : m_oldest + 1;
+    }
+
+    ++m_seen;
+    return m_sum;
+  }
+
+  I m_underlying;
+  size_t m_window;
+  size_t m_seen;
+  size_t m_oldest;
+  std::vector<Value> m_items;
+  Value m_sum;
+};
+
+template<typename I>
+struct Types<RollingSum<I>> {
+  using Output = OutputType<I>;
+};
+
+/**
+ * Divides sums of `count` items by `count`. Integer sums give doubles.
+ */
+template<typename T>
+struct Mean {
+  using Output = std::conditional_t<std::is_integral_v<T>, double, T>;
+
+  size_t count;
+
+  Output operator()(const T &sum) const { return Output(sum) / Output(count); }
+};
+
+/**
+ * Yields the smallest of each `window` consecutive items, where `C`
+ * is the less than comparison. With `std::greater<>` it yields the
+ * largest. The candidates are kept in a deque where each is ordered
+ * before all later ones, so each step is amortized constant time.
+ */
+template<typename C, typename I>
+class RollingExtreme : public Iterator<RollingExtreme<C, I>> {
+ public:
+  explicit RollingExtreme(size_t window, Iterator<I> &&underlying)
+          : m_underlying(static_cast<I &&>(underlying)),
+            m_window(std::max<size_t>(1, window)), m_seen(0) {}
+
+  RollingExtreme(const RollingExtreme &) = delete;
+  RollingExtreme(RollingExtreme &&) noexcept = default;
+  RollingExtreme &operator=(RollingExtreme &&) noexcept = default;
+  RollingExtreme &operator=(const RollingExtreme &) = delete;
+
+  [[nodiscard]] std::optional<OutputType<RollingExtreme<C, I>>> next() {
+    if (!fill()) { return {}; }
+
+    auto content = m_underlying.next();
+    if (!content.has_value()) { return {}; }
+
+    return push(std::move(content.value()));
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    return rolling_hint(m_underlying.size_hint(), m_seen, m_window);
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    if (!fill()) { return true; }
+
+    return m_underlying.for_each_while([&](auto &&content) {
+      return sink(push(std::forward<decltype(content)>(content)));
+    });
+  }
+
+ private:
+  using Value = OutputType<I>;
+
+  bool fill() {
+    if (m_seen + 1 >= m_window) { return true; }
+
+    m_underlying.for_each_while([&](auto &&content) {
+      push(std::forward<decltype(content)>(content));
+      return m_seen + 1 < m_window;
+    });
+
+    return m_seen + 1 >= m_window;
+  }
+
+  /**
+   * Adds an item to the window and returns the extreme of the window
+   */
+  Value push(Value content) {
+    C before;
+
+    while (!m_candidates.empty() && !before(m_candidates.back().second, content)) {
+      m_candidates.pop_back();
+    }
+
+    m_candidates.emplace_back(m_seen, std::move(content));
+    ++m_seen;
+
+    while (m_candidates.front().first + m_window < m_seen) {
+      m_candidates.pop_front();
+    }
+
+    return m_candidates.front().second;
+  }
+
+  I m_underlying;
+  size_t m_window;
+  size_t m_seen;
+  std::deque<std::pair<size_t, Value>> m_candidates;
+};
+
+template<typename C, typename I>
+struct Types<RollingExtreme<C, I>> {
+  using Output = OutputType<I>;
+};
+
+}
@@ -32,6 +32,35 @@ class Scan : public Iterator<Scan<T, F, I>> {
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    if (!m_value.has_value()) { return SizeHint::exact(0); }
+
+    return m_underlying.size_hint() + SizeHint::exact(1);
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    if (!m_value.has_value()) { return true; }
+
+    T value = std::move(*m_value);
+    m_value = {};
+
+    bool stopped = false;
+    m_underlying.for_each_while([&](auto &&x) {
+      T output = value;
+      value = m_func(output, x);
+      stopped = !sink(std::move(output));
+      return !stopped;
+    });
+
+    if (stopped) {
+      m_value = std::move(value);
+      return false;
+    }
+
+    return sink(std::move(value));
+  }
+
  private:
   I m_underlying;
   std::optional<T> m_value;
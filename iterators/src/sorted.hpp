@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../inc/interface.hpp"
+
+namespace colex::iterator {
+
+/**
+ * Marks the items of the underlying iterator as being in
+ * ascending order, so collectors can take sorted fast paths
+ */
+template<typename I>
+class Sorted : public Iterator<Sorted<I>> {
+ public:
+  static constexpr bool sorted = true;
+  static constexpr bool batched = is_batched_v<I>;
+  static constexpr bool random_access = is_random_access_v<I>;
+  static constexpr bool contiguous = is_contiguous_v<I>;
+  static constexpr bool splittable = is_splittable_v<I>;
+
+  explicit Sorted(Iterator<I> &&underlying)
+          : m_underlying(static_cast<I &&>(underlying)) {}
+
+  Sorted(const Sorted &) = delete;
+  Sorted(Sorted &&) noexcept = default;
+  Sorted &operator=(Sorted &&) noexcept = default;
+  Sorted &operator=(const Sorted &) = delete;
+
+  [[nodiscard]] std::optional<OutputType<Sorted<I>>> next() {
+    return m_underlying.next();
+  }
+
+  [[nodiscard]] SizeHint size_hint() const { return m_underlying.size_hint(); }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    return m_underlying.for_each_while(std::forward<S>(sink));
+  }
+
+  size_t next_batch(OutputType<I> *out, size_t max) {
+    return m_underlying.next_batch(out, max);
+  }
+
+  void advance(size_t n) { m_underlying.advance(n); }
+
+  void truncate(size_t n) { m_underlying.truncate(n); }
+
+  [[nodiscard]] const OutputType<I> *data() const { return m_underlying.data(); }
+
+  Sorted split(size_t n) { return Sorted(m_underlying.split(n)); }
+
+ private:
+  I m_underlying;
+};
+
+template<typename I>
+struct Types<Sorted<I>> {
+  using Output = OutputType<I>;
+};
+
+}
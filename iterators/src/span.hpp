@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace colex::iterator {
+
+/**
+ * The extent of spans whose length is only known at runtime
+ */
+constexpr size_t dynamic_extent = std::numeric_limits<size_t>::max();
+
+/**
+ * A view of `N` consecutive elements owned by someone else, like
+ * `std::span<const T, N>`. Converts to a `std::array` holding copies.
+ */
+template<typename T, size_t N>
+class Span {
+ public:
+  explicit Span(const T *data) : m_data(data) {}
+
+  [[nodiscard]] const T *data() const { return m_data; }
+
+  [[nodiscard]] static constexpr size_t size() { return N; }
+
+  [[nodiscard]] const T &operator[](size_t i) const { return m_data[i]; }
+
+  [[nodiscard]] const T &front() const { return m_data[0]; }
+
+  [[nodiscard]] const T &back() const { return m_data[N - 1]; }
+
+  [[nodiscard]] const T *begin() const { return m_data; }
+
+  [[nodiscard]] const T *end() const { return m_data + N; }
+
+  operator std::array<T, N>() const {
+    return to_array(std::make_index_sequence<N>());
+  }
+
+ private:
+  template<size_t... Is>
+  std::array<T, N> to_array(std::index_sequence<Is...>) const {
+    return {m_data[Is]...};
+  }
+
+  const T *m_data;
+};
+
+/**
+ * A view of consecutive elements where the count is only known at runtime
+ */
+template<typename T>
+class Span<T, dynamic_extent> {
+ public:
+  explicit Span(const T *data, size_t size) : m_data(data), m_size(size) {}
+
+  [[nodiscard]] const T *data() const { return m_data; }
+
+  [[nodiscard]] size_t size() const { return m_size; }
+
+  [[nodiscard]] const T &operator[](size_t i) const { return m_data[i]; }
+
+  [[nodiscard]] const T &front() const { return m_data[0]; }
+
+  [[nodiscard]] const T &back() const { return m_data[m_size - 1]; }
+
+  [[nodiscard]] const T *begin() const { return m_data; }
+
+  [[nodiscard]] const T *end() const { return m_data + m_size; }
+
+ private:
+  const T *m_data;
+  size_t m_size;
+};
+
+}
@@ -2,8 +2,11 @@
 
 #include "../inc/interface.hpp"
 
-#include <set>
 #include <array>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <vector>
 
 namespace colex::iterator {
 
@@ -13,8 +16,16 @@ namespace colex::iterator {
 template<template<typename...> typename C, typename T>
 class STL : public Iterator<STL<C, T>> {
  public:
+  static constexpr bool batched = true;
+  static constexpr bool random_access =
+          is_random_access_iterator_v<typename C<T>::const_iterator>;
+  static constexpr bool splittable = random_access;
+  static constexpr bool contiguous = is_vector_v<C<T>>;
+  static constexpr bool sorted = is_sorted_container_v<C<T>>;
+
   explicit STL(const C<T> &underlying)
-          : it(underlying.begin()), end(underlying.end()) {}
+          : it(underlying.begin()), end(underlying.end()),
+            remaining(underlying.size()) {}
 
   STL(const STL &) = delete;
   STL(STL &&) noexcept = default;
@@ -22,14 +33,83 @@ class STL : public Iterator<STL<C, T>> {
   STL &operator=(const STL &) = delete;
 
   [[nodiscard]] std::optional<OutputType<STL<C, T>>> next() {
-    if (it != end) { return *(it++); }
+    if (it != end) {
+      --remaining;
+      return *(it++);
+    }
 
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const { return SizeHint::exact(remaining); }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    auto current = it;
+    size_t left = remaining;
+    bool exhausted = true;
+
+    while (current != end) {
+      --left;
+
+      if (!sink(T(*(current++)))) {
+        exhausted = false;
+        break;
+      }
+    }
+
+    it = current;
+    remaining = left;
+    return exhausted;
+  }
+
+  size_t next_batch(T *out, size_t max) {
+    size_t n = std::min(max, remaining);
+    remaining -= n;
+
+    if constexpr (random_access) {
+      std::copy(it, it + n, out);
+      it += n;
+    } else {
+      for (size_t k = 0; k < n; ++k) { out[k] = *(it++); }
+    }
+
+    return n;
+  }
+
+  void advance(size_t n) {
+    size_t k = std::min(n, remaining);
+    it += k;
+    remaining -= k;
+  }
+
+  void truncate(size_t n) {
+    if (n < remaining) {
+      end = it + n;
+      remaining = n;
+    }
+  }
+
+  [[nodiscard]] const T *data() const {
+    return remaining > 0 ? std::addressof(*it) : nullptr;
+  }
+
+  STL split(size_t n) {
+    size_t k = std::min(n, remaining);
+    STL front(it, it + k, k);
+    advance(k);
+
+    return front;
+  }
+
  private:
+  explicit STL(typename C<T>::const_iterator it,
+               typename C<T>::const_iterator end, size_t remaining)
+          : it(it), end(end), remaining(remaining) {}
+
   typename C<T>::const_iterator it;
   typename C<T>::const_iterator end;
+  size_t remaining;
 };
 
 template<template<typename...> typename C, typename T>
@@ -43,49 +123,72 @@ struct Types<STL<C, T>> {
 template<template<typename...> typename C, typename T>
 struct STLMove : public Iterator<STLMove<C, T>> {
  public:
+  static constexpr bool random_access =
+          is_random_access_iterator_v<typename C<T>::iterator>;
+  static constexpr bool contiguous = is_vector_v<C<T>>;
+
   explicit STLMove(C<T> &&_underlying)
-          : underlying(std::move(_underlying)), it(underlying.begin()) {}
+          : underlying(std::move(_underlying)), it(underlying.begin()),
+            remaining(underlying.size()) {}
 
   STLMove(const STLMove &) = delete;
   STLMove(STLMove &&) noexcept = default;
-  STLMove &operator=(STLMove &&) noexcept = default;
   STLMove &operator=(const STLMove &) = delete;
 
+  /**
+   * Not assignable, since `std::pmr` containers with different resources
+   * move their items one by one, which would leave `it` pointing into
+   * the other iterator's storage
+   */
+  STLMove &operator=(STLMove &&) = delete;
+
   [[nodiscard]] std::optional<OutputType<STLMove<C, T>>> next() {
-    if (it != underlying.end()) { return std::move(*(it++)); }
+    if (remaining > 0) {
+      --remaining;
+      return std::move(*(it++));
+    }
 
     return {};
   }
 
- private:
-  C<T> underlying;
-  typename C<T>::iterator it;
-};
+  [[nodiscard]] SizeHint size_hint() const { return SizeHint::exact(remaining); }
 
-/**
- * `std::set` requires special treatment
- */
-template<typename T>
-struct STLMove<std::set, T> : public Iterator<STLMove<std::set, T>> {
- public:
-  explicit STLMove(std::set<T> &&underlying)
-          : underlying(std::move(underlying)) {}
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    auto current = it;
+    size_t left = remaining;
+    bool exhausted = true;
 
-  STLMove(const STLMove &) = delete;
-  STLMove(STLMove &&) noexcept = default;
-  STLMove &operator=(STLMove &&) noexcept = default;
-  STLMove &operator=(const STLMove &) = delete;
+    while (left > 0) {
+      --left;
 
-  [[nodiscard]] std::optional<OutputType<STLMove<std::set, T>>> next() {
-    if (!underlying.empty()) {
-      return std::move(underlying.extract(underlying.begin()).value());
+      if (!sink(std::move(*(current++)))) {
+        exhausted = false;
+        break;
+      }
     }
 
-    return {};
+    it = current;
+    remaining = left;
+    return exhausted;
+  }
+
+  void advance(size_t n) {
+    size_t k = std::min(n, remaining);
+    it += k;
+    remaining -= k;
+  }
+
+  void truncate(size_t n) { remaining = std::min(n, remaining); }
+
+  [[nodiscard]] const T *data() const {
+    return remaining > 0 ? std::addressof(*it) : nullptr;
   }
 
  private:
-  std::set<T> underlying;
+  C<T> underlying;
+  typename C<T>::iterator it;
+  size_t remaining;
 };
 
 template<template<typename...> typename C, typename T>
@@ -99,8 +202,11 @@ struct Types<STLMove<C, T>> {
 template<template<typename...> typename C, typename K, typename V>
 class STLPair : public Iterator<STLPair<C, K, V>> {
  public:
+  static constexpr bool sorted = is_sorted_container_v<C<K, V>>;
+
   explicit STLPair(const C<K, V> &underlying)
-          : it(underlying.begin()), end(underlying.end()) {}
+          : it(underlying.begin()), end(underlying.end()),
+            remaining(underlying.size()) {}
 
   STLPair(const STLPair &) = delete;
   STLPair(STLPair &&) noexcept = default;
@@ -108,48 +214,44 @@ class STLPair : public Iterator<STLPair<C, K, V>> {
   STLPair &operator=(const STLPair &) = delete;
 
   [[nodiscard]] std::optional<OutputType<STLPair<C, K, V>>> next() {
-    if (it != end) { return *(it++); }
+    if (it != end) {
+      --remaining;
+      return *(it++);
+    }
 
     return {};
   }
 
- private:
-  typename C<K, V>::const_iterator it;
-  typename C<K, V>::const_iterator end;
-};
-
-template<template<typename...> typename C, typename K, typename V>
-struct Types<STLPair<C, K, V>> {
-  using Output = std::pair<K, V>;
-};
+  [[nodiscard]] SizeHint size_hint() const { return SizeHint::exact(remaining); }
 
-/**
- * An iterator over an owned STL collection where the elements are pairs.
- */
-template<template<typename...> typename C, typename K, typename V>
-class STLPairMove : public Iterator<STLPairMove<C, K, V>> {
- public:
-  explicit STLPairMove(C<K, V> &&_underlying)
-          : underlying(std::move(_underlying)), it(underlying.begin()) {}
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    auto current = it;
+    size_t left = remaining;
+    bool exhausted = true;
 
-  STLPairMove(const STLPairMove &) = delete;
-  STLPairMove(STLPairMove &&) noexcept = default;
-  STLPairMove &operator=(STLPairMove &&) noexcept = default;
-  STLPairMove &operator=(const STLPairMove &) = delete;
+    while (current != end) {
+      --left;
 
-  [[nodiscard]] std::optional<OutputType<STLPairMove<C, K, V>>> next() {
-    if (it != underlying.end()) { return std::move(*(it++)); }
+      if (!sink(std::pair<K, V>(*(current++)))) {
+        exhausted = false;
+        break;
+      }
+    }
 
-    return {};
+    it = current;
+    remaining = left;
+    return exhausted;
   }
 
  private:
-  C<K, V> underlying;
-  typename C<K, V>::iterator it;
+  typename C<K, V>::const_iterator it;
+  typename C<K, V>::const_iterator end;
+  size_t remaining;
 };
 
 template<template<typename...> typename C, typename K, typename V>
-struct Types<STLPairMove<C, K, V>> {
+struct Types<STLPair<C, K, V>> {
   using Output = std::pair<K, V>;
 };
 
@@ -159,8 +261,11 @@ struct Types<STLPairMove<C, K, V>> {
 template<typename T, size_t N>
 class Array : public Iterator<Array<T, N>> {
  public:
+  static constexpr bool random_access = true;
+  static constexpr bool contiguous = true;
+
   explicit Array(const std::array<T, N> &underlying)
-          : i(0), underlying(underlying) {}
+          : i(0), m_end(N), underlying(underlying) {}
 
   Array(const Array &) = delete;
   Array(Array &&) noexcept = default;
@@ -168,13 +273,31 @@ class Array : public Iterator<Array<T, N>> {
   Array &operator=(const Array &) = delete;
 
   [[nodiscard]] std::optional<OutputType<Array<T, N>>> next() {
-    if (i < N) { return underlying[i++]; }
+    if (i < m_end) { return underlying[i++]; }
 
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const { return SizeHint::exact(m_end - i); }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    while (i < m_end) {
+      if (!sink(T(underlying[i++]))) { return false; }
+    }
+
+    return true;
+  }
+
+  void advance(size_t n) { i += std::min(n, m_end - i); }
+
+  void truncate(size_t n) { m_end = i + std::min(n, m_end - i); }
+
+  [[nodiscard]] const T *data() const { return underlying.data() + i; }
+
  private:
   size_t i;
+  size_t m_end;
   const std::array<T, N> &underlying;
 };
 
@@ -189,8 +312,11 @@ struct Types<Array<T, N>> {
 template<typename T, size_t N>
 class ArrayMove : public Iterator<ArrayMove<T, N>> {
  public:
+  static constexpr bool random_access = true;
+  static constexpr bool contiguous = true;
+
   explicit ArrayMove(std::array<T, N> &&underlying)
-          : i(0), underlying(std::move(underlying)) {}
+          : i(0), m_end(N), underlying(std::move(underlying)) {}
 
   ArrayMove(const ArrayMove &) = delete;
   ArrayMove(ArrayMove &&) noexcept = default;
@@ -198,13 +324,31 @@ class ArrayMove : public Iterator<ArrayMove<T, N>> {
   ArrayMove &operator=(const ArrayMove &) = delete;
 
   [[nodiscard]] std::optional<OutputType<ArrayMove<T, N>>> next() {
-    if (i < N) { return std::move(underlying[i++]); }
+    if (i < m_end) { return std::move(underlying[i++]); }
 
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const { return SizeHint::exact(m_end - i); }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    while (i < m_end) {
+      if (!sink(std::move(underlying[i++]))) { return false; }
+    }
+
+    return true;
+  }
+
+  void advance(size_t n) { i += std::min(n, m_end - i); }
+
+  void truncate(size_t n) { m_end = i + std::min(n, m_end - i); }
+
+  [[nodiscard]] const T *data() const { return underlying.data() + i; }
+
  private:
   size_t i;
+  size_t m_end;
   std::array<T, N> underlying;
 };
 
@@ -7,6 +7,8 @@ namespace colex::iterator {
 template<typename I>
 class Take : public Iterator<Take<I>> {
  public:
+  static constexpr bool sorted = is_sorted_v<I>;
+
   explicit Take(size_t count, Iterator<I> &&iter)
           : i(0), take_count(count), underlying(static_cast<I &&>(iter)) {}
 
@@ -21,6 +23,24 @@ class Take : public Iterator<Take<I>> {
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    return clamp(underlying.size_hint(), i < take_count ? take_count - i : 0);
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    if (i >= take_count) { return true; }
+
+    bool stopped = false;
+    underlying.for_each_while([&](auto &&content) {
+      ++i;
+      stopped = !sink(std::forward<decltype(content)>(content));
+      return !stopped && i < take_count;
+    });
+
+    return !stopped;
+  }
+
  private:
   size_t i;
   size_t take_count;
@@ -49,6 +69,24 @@ class TakeRef : public Iterator<TakeRef<I>> {
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    return clamp(underlying.size_hint(), i < take_count ? take_count - i : 0);
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    if (i >= take_count) { return true; }
+
+    bool stopped = false;
+    underlying.for_each_while([&](auto &&content) {
+      ++i;
+      stopped = !sink(std::forward<decltype(content)>(content));
+      return !stopped && i < take_count;
+    });
+
+    return !stopped;
+  }
+
  private:
   size_t i;
   size_t take_count;
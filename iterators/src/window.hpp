@@ -1,15 +1,28 @@
 #pragma once
 
 #include "../inc/interface.hpp"
+#include "span.hpp"
+
+#include <vector>
 
 namespace colex::iterator {
 
+/**
+ * Yields views of each `N` consecutive items. Over contiguous
+ * iterators the views point into the underlying data. Other
+ * iterators are buffered in a ring buffer of twice the window
+ * length, where each item is stored twice, so that the latest
+ * `N` items always lie next to each other. Either way, each step
+ * is constant time. A view is valid until the next call to the
+ * iterator, or for as long as the underlying data if it's contiguous.
+ */
 template<size_t N, typename I>
 class Window : public Iterator<Window<N, I>> {
  public:
   explicit Window(Iterator<I> &&iter)
-          : m_underlying(static_cast<I &&>(iter)), m_start_index(0) {
-    for (size_t i = 0; i < N; ++i) { m_elements[i] = m_underlying.next(); }
+          : m_underlying(static_cast<I &&>(iter)), m_start(0), m_full(false),
+            m_shift_pending(false) {
+    if constexpr (!is_contiguous_v<I>) { fill(); }
   }
 
   Window(const Window &) = delete;
@@ -17,36 +30,236 @@ class Window : public Iterator<Window<N, I>> {
   Window &operator=(Window &&) noexcept = default;
   Window &operator=(const Window &) = delete;
 
-  [[nodiscard]] bool last_is_none() const {
-    if (m_start_index == 0) { return !m_elements[N - 1].has_value(); }
+  [[nodiscard]] std::optional<OutputType<Window<N, I>>> next() {
+    if constexpr (is_contiguous_v<I>) {
+      if (m_underlying.size_hint().lower < N) { return {}; }
+
+      OutputType<Window<N, I>> view(m_underlying.data());
+      m_underlying.advance(1);
+
+      return view;
+    } else {
+      if (!shift()) { return {}; }
 
-    return !m_elements[m_start_index - 1].has_value();
+      m_shift_pending = true;
+      return OutputType<Window<N, I>>(m_buffer.data() + m_start);
+    }
   }
 
-  [[nodiscard]] std::optional<OutputType<Window<N, I>>> next() {
-    if (last_is_none()) { return {}; }
+  [[nodiscard]] SizeHint size_hint() const {
+    if constexpr (is_contiguous_v<I>) {
+      size_t remaining = m_underlying.size_hint().lower;
+      return SizeHint::exact(remaining < N ? 0 : remaining - N + 1);
+    } else {
+      if (!m_full) { return SizeHint::exact(0); }
 
-    std::array<OutputType<I>, N> content;
-    for (size_t i = 0; i < N; ++i) {
-      size_t j = (m_start_index + i) % N;
-      content[i] = m_elements[j].value();
+      return m_underlying.size_hint() + SizeHint::exact(m_shift_pending ? 0 : 1);
     }
+  }
 
-    m_elements[m_start_index] = m_underlying.next();
-    m_start_index = (m_start_index + 1) % N;
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    for (;;) {
+      auto content = next();
 
-    return std::move(content);
+      if (!content.has_value()) { return true; }
+      if (!sink(std::move(content.value()))) { return false; }
+    }
   }
 
  private:
+  using Value = OutputType<I>;
+
+  /**
+   * Pulls the first window from the underlying iterator
+   */
+  void fill() {
+    m_buffer.reserve(2 * N);
+    m_underlying.for_each_while([&](auto &&content) {
+      m_buffer.push_back(std::forward<decltype(content)>(content));
+      return m_buffer.size() < N;
+    });
+
+    m_full = m_buffer.size() == N;
+    if (!m_full) { return; }
+
+    for (size_t i = 0; i < N; ++i) { m_buffer.push_back(m_buffer[i]); }
+  }
+
+  /**
+   * Replaces the oldest item with the next one, if the previous view
+   * has been handed out. The oldest item is stored at both `m_start`
+   * and `m_start + N`, so the window stays contiguous. Returns false
+   * if there is no next window.
+   */
+  bool shift() {
+    if (!m_full) { return false; }
+    if (!m_shift_pending) { return true; }
+
+    auto content = m_underlying.next();
+    if (!content.has_value()) {
+      m_full = false;
+      return false;
+    }
+
+    m_buffer[m_start] = content.value();
+    m_buffer[m_start + N] = std::move(content.value());
+    m_start = (m_start + 1) % N;
+    m_shift_pending = false;
+
+    return true;
+  }
+
   I m_underlying;
-  size_t m_start_index;
-  std::array<std::optional<OutputType<I>>, N> m_elements;
+  std::vector<Value> m_buffer;
+  size_t m_start;
+  bool m_full;
+  bool m_shift_pending;
 };
 
 template<size_t N, typename I>
 struct Types<Window<N, I>> {
-  using Output = std::array<OutputType<I>, N>;
+  using Output = Span<OutputType<I>, N>;
+};
+
+/**
+ * Yields views of `size` consecutive items, starting a new view every
+ * `hop` items. Over contiguous iterators the views point into the
+ * underlying data. Other iterators are buffered in a single buffer
+ * of twice the window size, which is compacted when the window
+ * reaches its end. A view is valid until the next call to the
+ * iterator, or for as long as the underlying data if it's contiguous.
+ * A `size` or `hop` of 0 is treated as 1.
+ */
+template<typename I>
+class DynamicWindow : public Iterator<DynamicWindow<I>> {
+ public:
+  explicit DynamicWindow(size_t size, size_t hop, Iterator<I> &&iter)
+          : m_underlying(static_cast<I &&>(iter)), m_size(std::max<size_t>(1, size)),
+            m_hop(std::max<size_t>(1, hop)), m_begin(0), m_exhausted(false),
+            m_shift_pending(false) {
+    if constexpr (!is_contiguous_v<I>) { m_buffer.reserve(2 * m_size); }
+  }
+
+  DynamicWindow(const DynamicWindow &) = delete;
+  DynamicWindow(DynamicWindow &&) noexcept = default;
+  DynamicWindow &operator=(DynamicWindow &&) noexcept = default;
+  DynamicWindow &operator=(const DynamicWindow &) = delete;
+
+  [[nodiscard]] std::optional<OutputType<DynamicWindow<I>>> next() {
+    if constexpr (is_contiguous_v<I>) {
+      if (m_underlying.size_hint().lower < m_size) { return {}; }
+
+      OutputType<DynamicWindow<I>> view(m_underlying.data(), m_size);
+      m_underlying.advance(m_hop);
+
+      return view;
+    } else {
+      if (!shift()) { return {}; }
+
+      m_shift_pending = true;
+      return OutputType<DynamicWindow<I>>(m_buffer.data() + m_begin, m_size);
+    }
+  }
+
+  [[nodiscard]] SizeHint size_hint() const {
+    SizeHint items = m_underlying.size_hint();
+
+    if constexpr (!is_contiguous_v<I>) {
+      if (m_exhausted) { return SizeHint::exact(0); }
+
+      size_t begin = m_shift_pending ? m_begin + m_hop : m_begin;
+      size_t buffered = m_buffer.size();
+      items = items + SizeHint::exact(buffered);
+      items = {items.lower - std::min(items.lower, begin),
+               items.upper.has_value()
+               ? std::optional<size_t>(items.upper.value() - std::min(items.upper.value(), begin))
+               : std::nullopt};
+    }
+
+    return {windows(items.lower),
+            items.upper.has_value()
+            ? std::optional<size_t>(windows(items.upper.value()))
+            : std::nullopt};
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    for (;;) {
+      auto content = next();
+
+      if (!content.has_value()) { return true; }
+      if (!sink(std::move(content.value()))) { return false; }
+    }
+  }
+
+ private:
+  /**
+   * The number of windows in `count` items
+   */
+  [[nodiscard]] size_t windows(size_t count) const {
+    return count < m_size ? 0 : (count - m_size) / m_hop + 1;
+  }
+
+  /**
+   * Moves the window `hop` items ahead if the previous view has been
+   * handed out, and pulls items until the window is full. Returns
+   * false if there are too few items left for another window.
+   */
+  bool shift() {
+    if (m_exhausted) { return false; }
+
+    if (m_shift_pending) {
+      m_begin += m_hop;
+      m_shift_pending = false;
+    }
+
+    if (m_begin >= m_buffer.size()) {
+      skip(m_begin - m_buffer.size());
+      m_buffer.clear();
+      m_begin = 0;
+    } else if (m_begin > m_size) {
+      m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_begin);
+      m_begin = 0;
+    }
+
+    size_t end = m_begin + m_size;
+    if (m_buffer.size() < end) {
+      m_underlying.for_each_while([&](auto &&content) {
+        m_buffer.push_back(std::forward<decltype(content)>(content));
+        return m_buffer.size() < end;
+      });
+    }
+
+    m_exhausted = m_buffer.size() < end;
+    return !m_exhausted;
+  }
+
+  /**
+   * Drops the next `count` underlying items
+   */
+  void skip(size_t count) {
+    if (count == 0) { return; }
+
+    if constexpr (is_random_access_v<I>) {
+      m_underlying.advance(count);
+    } else {
+      m_underlying.for_each_while([&](auto &&) { return --count > 0; });
+    }
+  }
+
+  I m_underlying;
+  std::vector<OutputType<I>> m_buffer;
+  size_t m_size;
+  size_t m_hop;
+  size_t m_begin;
+  bool m_exhausted;
+  bool m_shift_pending;
+};
+
+template<typename I>
+struct Types<DynamicWindow<I>> {
+  using Output = Span<OutputType<I>, dynamic_extent>;
 };
 
-}
\ No newline at end of file
+}
@@ -20,12 +20,34 @@ class Zip : public Iterator<Zip<I1, I2>> {
     auto r = right.next();
 
     if (l.has_value() && r.has_value()) {
-      return std::make_pair(std::move(l.value()), std::move(r.value()));
+      return OutputType<Zip<I1, I2>>(std::move(l.value()), std::move(r.value()));
     }
 
     return {};
   }
 
+  [[nodiscard]] SizeHint size_hint() const {
+    return min(left.size_hint(), right.size_hint());
+  }
+
+  template<typename S>
+  bool for_each_while(S &&sink) {
+    bool right_exhausted = false;
+    bool left_exhausted = left.for_each_while([&](auto &&l) {
+      auto r = right.next();
+
+      if (r.has_value()) {
+        return sink(OutputType<Zip<I1, I2>>(std::forward<decltype(l)>(l),
+                                            std::move(r.value())));
+      }
+
+      right_exhausted = true;
+      return false;
+    });
+
+    return left_exhausted || right_exhausted;
+  }
+
  private:
   I1 left;
   I2 right;
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "../src/compress.hpp"
+#include "../src/isa.hpp"
+#include "../src/reduce.hpp"
+#include "../src/search.hpp"
+#include "../src/stream.hpp"
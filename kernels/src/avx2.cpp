@@ -0,0 +1,10 @@
+#include "impl.hpp"
+
+// Compiled with AVX2 enabled, see CMakeLists.txt
+namespace colex::kernel {
+
+#if defined(__AVX2__)
+const Table &avx2_table() { return table_for<Isa::Avx2>(); }
+#endif
+
+}
@@ -0,0 +1,10 @@
+#include "impl.hpp"
+
+// Compiled with AVX-512 F, DQ and VL enabled, see CMakeLists.txt
+namespace colex::kernel {
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__) && defined(__AVX512VL__)
+const Table &avx512_table() { return table_for<Isa::Avx512>(); }
+#endif
+
+}
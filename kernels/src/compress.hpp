@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace colex::kernel {
+
+/**
+ * Copies the elements `xs[i]` where `keep[i]` is true to the front
+ * of `out`, preserving their order, and returns how many there were.
+ * `out` must have room for `n` elements, since the kernels may write
+ * past the last kept one. `out` may be equal to `xs`.
+ */
+template<typename T>
+size_t compress(const T *xs, const bool *keep, size_t n, T *out);
+
+}
@@ -0,0 +1,184 @@
+#include "compress.hpp"
+#include "isa.hpp"
+#include "reduce.hpp"
+#include "search.hpp"
+#include "table.hpp"
+
+#include <atomic>
+
+#if defined(COLEX_KERNELS_AVX2) || defined(__AVX2__)
+#define COLEX_HAS_AVX2
+#endif
+
+#if defined(COLEX_KERNELS_AVX512) \
+    || (defined(__AVX512F__) && defined(__AVX512DQ__) && defined(__AVX512VL__))
+#define COLEX_HAS_AVX512
+#endif
+
+namespace colex::kernel {
+
+namespace {
+
+/**
+ * True if this build contains the kernels for `isa`
+ */
+bool is_built(Isa isa) {
+  switch (isa) {
+    case Isa::Scalar: return true;
+#if defined(__SSE2__)
+    case Isa::Sse2: return true;
+#endif
+#if defined(COLEX_HAS_AVX2)
+    case Isa::Avx2: return true;
+#endif
+#if defined(COLEX_HAS_AVX512)
+    case Isa::Avx512: return true;
+#endif
+    default: return false;
+  }
+}
+
+/**
+ * True if the host can run code for `isa`. The checks
+ * include whether the OS saves the vector registers.
+ */
+bool host_supports(Isa isa) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+
+  switch (isa) {
+    case Isa::Scalar: return true;
+    case Isa::Sse2: return __builtin_cpu_supports("sse2");
+    case Isa::Avx2: return __builtin_cpu_supports("avx2");
+    case Isa::Avx512:
+      return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")
+             && __builtin_cpu_supports("avx512vl");
+  }
+
+  return false;
+#else
+  // Without a way to ask, trust the flags the kernels were compiled with
+  return true;
+#endif
+}
+
+const Table &table_of(Isa isa) {
+  switch (isa) {
+#if defined(__SSE2__)
+    case Isa::Sse2: return sse2_table();
+#endif
+#if defined(COLEX_HAS_AVX2)
+    case Isa::Avx2: return avx2_table();
+#endif
+#if defined(COLEX_HAS_AVX512)
+    case Isa::Avx512: return avx512_table();
+#endif
+    default: return scalar_table();
+  }
+}
+
+/**
+ * The instruction set in use and its kernels
+ */
+struct Active {
+  std::atomic<Isa> isa;
+  std::atomic<const Table *> table;
+
+  explicit Active(Isa isa) : isa(isa), table(&table_of(isa)) {}
+};
+
+Active &active() {
+  static Active state(best_supported_isa());
+  return state;
+}
+
+template<typename T>
+const Kernels<T> &kernels() {
+  return std::get<Kernels<T>>(*active().table.load(std::memory_order_relaxed));
+}
+
+}
+
+const char *isa_name(Isa isa) {
+  switch (isa) {
+    case Isa::Scalar: return "scalar";
+    case Isa::Sse2: return "sse2";
+    case Isa::Avx2: return "avx2";
+    case Isa::Avx512: return "avx512";
+  }
+
+  return "unknown";
+}
+
+bool is_supported(Isa isa) { return is_built(isa) && host_supports(isa); }
+
+Isa best_supported_isa() {
+  for (Isa isa : {Isa::Avx512, Isa::Avx2, Isa::Sse2}) {
+    if (is_supported(isa)) { return isa; }
+  }
+
+  return Isa::Scalar;
+}
+
+Isa active_isa() { return active().isa.load(std::memory_order_relaxed); }
+
+bool use_isa(Isa isa) {
+  if (!is_supported(isa)) { return false; }
+
+  active().table.store(&table_of(isa), std::memory_order_relaxed);
+  active().isa.store(isa, std::memory_order_relaxed);
+  return true;
+}
+
+template<typename T>
+T sum(const T *xs, size_t n) { return kernels<T>().sum(xs, n); }
+
+template<typename T>
+T product(const T *xs, size_t n) { return kernels<T>().product(xs, n); }
+
+template<typename T>
+T min(const T *xs, size_t n) { return kernels<T>().min(xs, n); }
+
+template<typename T>
+T max(const T *xs, size_t n) { return kernels<T>().max(xs, n); }
+
+template<typename T>
+std::pair<T, T> minmax(const T *xs, size_t n) { return kernels<T>().minmax(xs, n); }
+
+template<typename T>
+size_t count(const T *xs, size_t n, T value) {
+  return kernels<T>().count(xs, n, value);
+}
+
+template<typename T>
+size_t find(const T *xs, size_t n, T value) {
+  return kernels<T>().find(xs, n, value);
+}
+
+template<typename T>
+size_t compress(const T *xs, const bool *keep, size_t n, T *out) {
+  return kernels<T>().compress(xs, keep, n, out);
+}
+
+#define COLEX_INSTANTIATE_KERNELS(T)                                           \
+  template T sum<T>(const T *, size_t);                                        \
+  template T product<T>(const T *, size_t);                                    \
+  template T min<T>(const T *, size_t);                                        \
+  template T max<T>(const T *, size_t);                                        \
+  template std::pair<T, T> minmax<T>(const T *, size_t);                       \
+  template size_t count<T>(const T *, size_t, T);                              \
+  template size_t find<T>(const T *, size_t, T);                               \
+  template size_t compress<T>(const T *, const bool *, size_t, T *);
+
+COLEX_INSTANTIATE_KERNELS(int)
+COLEX_INSTANTIATE_KERNELS(unsigned)
+COLEX_INSTANTIATE_KERNELS(long)
+COLEX_INSTANTIATE_KERNELS(unsigned long)
+COLEX_INSTANTIATE_KERNELS(long long)
+COLEX_INSTANTIATE_KERNELS(unsigned long long)
+COLEX_INSTANTIATE_KERNELS(float)
+COLEX_INSTANTIATE_KERNELS(double)
+
+#undef COLEX_INSTANTIATE_KERNELS
+
+}
@@ -0,0 +1,375 @@
+#pragma once
+
+#include "lanes.hpp"
+#include "table.hpp"
+
+#include <cstring>
+
+namespace colex::kernel {
+
+// Internal linkage for the same reason as in lanes.hpp
+namespace {
+
+/**
+ * The next less capable instruction set
+ */
+constexpr Isa fallback(Isa isa) { return Isa(int(isa) - 1); }
+
+inline unsigned popcount(uint64_t bits) {
+#if defined(__POPCNT__)
+  return unsigned(__builtin_popcountll(bits));
+#else
+  // Without the instruction, the builtin is a library call
+  bits = bits - ((bits >> 1) & 0x5555555555555555u);
+  bits = (bits & 0x3333333333333333u) + ((bits >> 2) & 0x3333333333333333u);
+  bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0Fu;
+  return unsigned((bits * 0x0101010101010101u) >> 56);
+#endif
+}
+
+/**
+ * The index of the lowest set bit. Requires that `bits` isn't zero.
+ */
+inline unsigned lowest_bit(unsigned bits) {
+#if defined(__GNUC__)
+  return unsigned(__builtin_ctz(bits));
+#else
+  unsigned n = 0;
+  for (; (bits & 1) == 0; bits >>= 1) { ++n; }
+  return n;
+#endif
+}
+
+/**
+ * Integers are combined as unsigned, so overflow wraps instead of being undefined
+ */
+template<typename T>
+using Wrapping = typename std::conditional_t<std::is_integral_v<T>,
+                                             std::make_unsigned<T>,
+                                             std::common_type<T>>::type;
+
+struct Add {
+  template<typename L>
+  static auto vector(typename L::Reg acc, typename L::Reg x) -> decltype(L::add(acc, x)) {
+    return L::add(acc, x);
+  }
+
+  template<typename T>
+  static T scalar(T acc, T x) { return T(Wrapping<T>(acc) + Wrapping<T>(x)); }
+};
+
+struct Mul {
+  template<typename L>
+  static auto vector(typename L::Reg acc, typename L::Reg x) -> decltype(L::mul(acc, x)) {
+    return L::mul(acc, x);
+  }
+
+  template<typename T>
+  static T scalar(T acc, T x) { return T(Wrapping<T>(acc) * Wrapping<T>(x)); }
+};
+
+struct Min {
+  template<typename L>
+  static auto vector(typename L::Reg acc, typename L::Reg x) -> decltype(L::min(x, acc)) {
+    return L::min(x, acc);
+  }
+
+  template<typename T>
+  static T scalar(T acc, T x) { return x < acc ? x : acc; }
+};
+
+struct Max {
+  template<typename L>
+  static auto vector(typename L::Reg acc, typename L::Reg x) -> decltype(L::max(x, acc)) {
+    return L::max(x, acc);
+  }
+
+  template<typename T>
+  static T scalar(T acc, T x) { return acc < x ? x : acc; }
+};
+
+/**
+ * Detects whether `Op` can be done with the lanes `L`
+ */
+template<typename Op, typename L, typename = void>
+struct Supports : std::false_type {};
+
+template<typename Op, typename L>
+struct Supports<Op, L, std::void_t<decltype(sizeof(&Op::template vector<L>))>>
+        : std::true_type {};
+
+template<typename L, typename = void>
+struct HasEq : std::false_type {};
+
+template<typename L>
+struct HasEq<L, std::void_t<decltype(sizeof(&L::eq))>> : std::true_type {};
+
+/**
+ * Folds `xs[0..n)` into `identity` with `Op`, using four independent
+ * vector accumulators to hide the latency of the operation.
+ * `identity` is folded into every lane, so it must not change the result.
+ */
+template<typename L, typename Op, typename T>
+T reduce_lanes(const T *xs, size_t n, T identity) {
+  constexpr size_t width = L::width;
+
+  auto a0 = L::set1(identity);
+  auto a1 = a0;
+  auto a2 = a0;
+  auto a3 = a0;
+
+  size_t i = 0;
+  for (; i + 4 * width <= n; i += 4 * width) {
+    a0 = Op::template vector<L>(a0, L::load(xs + i));
+    a1 = Op::template vector<L>(a1, L::load(xs + i + width));
+    a2 = Op::template vector<L>(a2, L::load(xs + i + 2 * width));
+    a3 = Op::template vector<L>(a3, L::load(xs + i + 3 * width));
+  }
+
+  for (; i + width <= n; i += width) {
+    a0 = Op::template vector<L>(a0, L::load(xs + i));
+  }
+
+  a0 = Op::template vector<L>(Op::template vector<L>(a0, a1),
+                              Op::template vector<L>(a2, a3));
+
+  T lanes[width];
+  L::store(lanes, a0);
+
+  T result = lanes[0];
+  for (size_t k = 1; k < width; ++k) { result = Op::scalar(result, lanes[k]); }
+  for (; i < n; ++i) { result = Op::scalar(result, xs[i]); }
+
+  return result;
+}
+
+/**
+ * Reduces with the most capable instruction set up to `I` that supports `Op` on `T`
+ */
+template<Isa I, typename Op, typename T>
+T reduce(const T *xs, size_t n, T identity) {
+  using L = Lanes<I, kind_of_v<T>>;
+
+  if constexpr (I == Isa::Scalar) {
+    T result = identity;
+    for (size_t i = 0; i < n; ++i) { result = Op::scalar(result, xs[i]); }
+
+    return result;
+  } else if constexpr (Supports<Op, L>::value) {
+    return reduce_lanes<L, Op>(xs, n, identity);
+  } else {
+    return reduce<fallback(I), Op>(xs, n, identity);
+  }
+}
+
+template<Isa I, typename T>
+size_t count(const T *xs, size_t n, T value) {
+  using L = Lanes<I, kind_of_v<T>>;
+
+  if constexpr (I == Isa::Scalar) {
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) { total += xs[i] == value; }
+
+    return total;
+  } else if constexpr (HasEq<L>::value) {
+    auto needle = L::set1(value);
+    size_t total = 0;
+    size_t i = 0;
+
+    // The masks of four vectors fit in one 64 bit word
+    constexpr size_t width = L::width;
+    for (; i + 4 * width <= n; i += 4 * width) {
+      total += popcount(uint64_t(L::eq(L::load(xs + i), needle))
+                        | uint64_t(L::eq(L::load(xs + i + width), needle)) << width
+                        | uint64_t(L::eq(L::load(xs + i + 2 * width), needle)) << 2 * width
+                        | uint64_t(L::eq(L::load(xs + i + 3 * width), needle)) << 3 * width);
+    }
+
+    for (; i + width <= n; i += width) {
+      total += popcount(L::eq(L::load(xs + i), needle));
+    }
+
+    return total + count<Isa::Scalar>(xs + i, n - i, value);
+  } else {
+    return count<fallback(I)>(xs, n, value);
+  }
+}
+
+template<Isa I, typename T>
+size_t find(const T *xs, size_t n, T value) {
+  using L = Lanes<I, kind_of_v<T>>;
+
+  if constexpr (I == Isa::Scalar) {
+    size_t i = 0;
+    while (i < n && !(xs[i] == value)) { ++i; }
+
+    return i;
+  } else if constexpr (HasEq<L>::value) {
+    auto needle = L::set1(value);
+    size_t i = 0;
+
+    for (; i + L::width <= n; i += L::width) {
+      unsigned equal = L::eq(L::load(xs + i), needle);
+      if (equal != 0) { return i + lowest_bit(equal); }
+    }
+
+    return i + find<Isa::Scalar>(xs + i, n - i, value);
+  } else {
+    return find<fallback(I)>(xs, n, value);
+  }
+}
+
+/**
+ * For each mask of `Count` lanes, the indices of the kept lanes followed
+ * by zeros. Each lane is made of `Parts` 32 bit parts.
+ */
+template<size_t Count, size_t Parts>
+struct CompressTable {
+  unsigned char indices[1 << Count][Count * Parts];
+
+  constexpr CompressTable() : indices() {
+    for (size_t mask = 0; mask < (1 << Count); ++mask) {
+      size_t n = 0;
+      for (size_t lane = 0; lane < Count; ++lane) {
+        if (mask & (1 << lane)) {
+          for (size_t part = 0; part < Parts; ++part) {
+            indices[mask][n++] = static_cast<unsigned char>(lane * Parts + part);
+          }
+        }
+      }
+    }
+  }
+};
+
+template<Isa I, typename T>
+size_t compress(const T *xs, const bool *keep, size_t n, T *out) {
+  size_t i = 0;
+  size_t k = 0;
+
+#if defined(__AVX512F__)
+  if constexpr (I == Isa::Avx512 && sizeof(T) == 4) {
+    for (; i + 16 <= n; i += 16) {
+      // The masked conversions avoid a bogus uninitialized warning in GCC 12
+      __m512i flags = _mm512_maskz_cvtepu8_epi32(0xFFFF, _mm_loadu_si128(
+              reinterpret_cast<const __m128i *>(keep + i)));
+      __mmask16 mask = _mm512_test_epi32_mask(flags, flags);
+      __m512i data = _mm512_loadu_si512(xs + i);
+      _mm512_storeu_si512(out + k, _mm512_maskz_compress_epi32(mask, data));
+      k += popcount(mask);
+    }
+  } else if constexpr (I == Isa::Avx512 && sizeof(T) == 8) {
+    for (; i + 8 <= n; i += 8) {
+      __m512i flags = _mm512_maskz_cvtepu8_epi64(0xFF, _mm_loadl_epi64(
+              reinterpret_cast<const __m128i *>(keep + i)));
+      __mmask8 mask = _mm512_test_epi64_mask(flags, flags);
+      __m512i data = _mm512_loadu_si512(xs + i);
+      _mm512_storeu_si512(out + k, _mm512_maskz_compress_epi64(mask, data));
+      k += popcount(mask);
+    }
+  }
+#endif
+
+#if defined(__AVX2__)
+  if constexpr (I == Isa::Avx2) {
+    // The table holds 32 bit lane indices, and 64 bit
+    // elements are moved as two 32 bit lanes each
+    constexpr size_t width = 32 / sizeof(T);
+    static constexpr CompressTable<width, sizeof(T) / 4> table;
+
+    for (; i + width <= n; i += width) {
+      unsigned mask;
+      if constexpr (sizeof(T) == 4) {
+        __m256i flags = _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+                reinterpret_cast<const __m128i *>(keep + i)));
+        mask = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(
+                _mm256_cmpgt_epi32(flags, _mm256_setzero_si256()))));
+      } else {
+        int bytes;
+        std::memcpy(&bytes, keep + i, sizeof(bytes));
+        __m256i flags = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(bytes));
+        mask = unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(
+                _mm256_cmpgt_epi64(flags, _mm256_setzero_si256()))));
+      }
+
+      long long indices;
+      std::memcpy(&indices, table.indices[mask], sizeof(indices));
+      __m256i permutation = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(indices));
+      __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(xs + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + k),
+                          _mm256_permutevar8x32_epi32(data, permutation));
+      k += popcount(mask);
+    }
+  }
+#endif
+
+  for (; i < n; ++i) {
+    out[k] = xs[i];
+    k += keep[i];
+  }
+
+  return k;
+}
+
+template<Isa I, typename T>
+struct Impl {
+  static T sum(const T *xs, size_t n) { return reduce<I, Add>(xs, n, T(0)); }
+
+  static T product(const T *xs, size_t n) { return reduce<I, Mul>(xs, n, T(1)); }
+
+  static T min(const T *xs, size_t n) { return reduce<I, Min>(xs, n, xs[0]); }
+
+  static T max(const T *xs, size_t n) { return reduce<I, Max>(xs, n, xs[0]); }
+
+  static std::pair<T, T> minmax(const T *xs, size_t n) {
+    // Both passes over a block are served from L1, so memory is only read once
+    constexpr size_t block = 4096 / sizeof(T);
+
+    T smallest = xs[0];
+    T largest = xs[0];
+
+    for (size_t i = 0; i < n; i += block) {
+      size_t count = n - i < block ? n - i : block;
+      smallest = Min::scalar(smallest, reduce<I, Min>(xs + i, count, xs[i]));
+      largest = Max::scalar(largest, reduce<I, Max>(xs + i, count, xs[i]));
+    }
+
+    return {smallest, largest};
+  }
+
+  static size_t count(const T *xs, size_t n, T value) {
+    return kernel::count<I>(xs, n, value);
+  }
+
+  static size_t find(const T *xs, size_t n, T value) {
+    return kernel::find<I>(xs, n, value);
+  }
+
+  static size_t compress(const T *xs, const bool *keep, size_t n, T *out) {
+    return kernel::compress<I>(xs, keep, n, out);
+  }
+};
+
+template<Isa I, typename T>
+constexpr Kernels<T> kernels_for() {
+  using K = Impl<I, T>;
+  return {K::sum, K::product, K::min, K::max,
+          K::minmax, K::count, K::find, K::compress};
+}
+
+/**
+ * The kernels of all element types on `I`
+ */
+template<Isa I>
+const Table &table_for() {
+  static const Table table(
+          kernels_for<I, int>(), kernels_for<I, unsigned>(),
+          kernels_for<I, long>(), kernels_for<I, unsigned long>(),
+          kernels_for<I, long long>(), kernels_for<I, unsigned long long>(),
+          kernels_for<I, float>(), kernels_for<I, double>());
+
+  return table;
+}
+
+}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+namespace colex::kernel {
+
+/**
+ * Instruction sets the kernels are built for, from least to most capable
+ */
+enum class Isa { Scalar, Sse2, Avx2, Avx512 };
+
+/**
+ * A readable name of `isa`, such as "avx2"
+ */
+const char *isa_name(Isa isa);
+
+/**
+ * True if this build has kernels for `isa` and the host can run them
+ */
+bool is_supported(Isa isa);
+
+/**
+ * The most capable supported instruction set
+ */
+Isa best_supported_isa();
+
+/**
+ * The instruction set the kernels currently use.
+ * This is the best supported one unless changed with `use_isa`.
+ */
+Isa active_isa();
+
+/**
+ * Makes the kernels use `isa`. Does nothing and
+ * returns false if `isa` isn't supported.
+ */
+bool use_isa(Isa isa);
+
+}
@@ -0,0 +1,330 @@
+#pragma once
+
+#include "isa.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace colex::kernel {
+
+// Everything here has internal linkage. The kernels for each instruction
+// set are compiled with different flags, and shared inline functions
+// would let the linker pick e.g. an AVX2 build of a function for SSE2 code.
+namespace {
+
+/**
+ * The element types that have kernels, grouped by their representation
+ */
+enum class Kind { Signed32, Unsigned32, Signed64, Unsigned64, Float, Double, None };
+
+template<typename T>
+constexpr Kind kind_of_v =
+        std::is_same_v<T, float> ? Kind::Float
+        : std::is_same_v<T, double> ? Kind::Double
+        : !std::is_integral_v<T> || std::is_same_v<T, bool> ? Kind::None
+        : sizeof(T) == 4 ? (std::is_signed_v<T> ? Kind::Signed32 : Kind::Unsigned32)
+        : sizeof(T) == 8 ? (std::is_signed_v<T> ? Kind::Signed64 : Kind::Unsigned64)
+        : Kind::None;
+
+/**
+ * The vector operations an instruction set has for elements of kind `K`.
+ * Only specialized for the instruction sets the translation unit is
+ * compiled for. Operations missing from a specialization are done
+ * with a less capable instruction set instead.
+ */
+template<Isa I, Kind K>
+struct Lanes {};
+
+#if defined(__SSE2__)
+
+template<size_t Size>
+struct Sse2Integer {
+  using Reg = __m128i;
+  static constexpr size_t width = 16 / Size;
+
+  static Reg load(const void *p) {
+    return _mm_loadu_si128(static_cast<const __m128i *>(p));
+  }
+  static void store(void *p, Reg a) {
+    _mm_storeu_si128(static_cast<__m128i *>(p), a);
+  }
+
+  /**
+   * One bit per lane, set where `a` and `b` are equal
+   */
+  static unsigned eq(Reg a, Reg b) {
+    Reg equal = _mm_cmpeq_epi32(a, b);
+    if constexpr (Size == 4) {
+      return unsigned(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+    } else {
+      // Both halves of a 64 bit lane must be equal
+      equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+      return unsigned(_mm_movemask_pd(_mm_castsi128_pd(equal)));
+    }
+  }
+};
+
+template<>
+struct Lanes<Isa::Sse2, Kind::Signed32> : Sse2Integer<4> {
+  static Reg set1(int32_t x) { return _mm_set1_epi32(x); }
+  static Reg add(Reg a, Reg b) { return _mm_add_epi32(a, b); }
+};
+
+template<>
+struct Lanes<Isa::Sse2, Kind::Unsigned32> : Sse2Integer<4> {
+  static Reg set1(uint32_t x) { return _mm_set1_epi32(int32_t(x)); }
+  static Reg add(Reg a, Reg b) { return _mm_add_epi32(a, b); }
+};
+
+template<>
+struct Lanes<Isa::Sse2, Kind::Signed64> : Sse2Integer<8> {
+  static Reg set1(int64_t x) { return _mm_set1_epi64x(x); }
+  static Reg add(Reg a, Reg b) { return _mm_add_epi64(a, b); }
+};
+
+template<>
+struct Lanes<Isa::Sse2, Kind::Unsigned64> : Sse2Integer<8> {
+  static Reg set1(uint64_t x) { return _mm_set1_epi64x(int64_t(x)); }
+  static Reg add(Reg a, Reg b) { return _mm_add_epi64(a, b); }
+};
+
+template<>
+struct Lanes<Isa::Sse2, Kind::Float> {
+  using Reg = __m128;
+  static constexpr size_t width = 4;
+
+  static Reg load(const void *p) { return _mm_loadu_ps(static_cast<const float *>(p)); }
+  static void store(void *p, Reg a) { _mm_storeu_ps(static_cast<float *>(p), a); }
+  static Reg set1(float x) { return _mm_set1_ps(x); }
+  static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+  static Reg min(Reg a, Reg b) { return _mm_min_ps(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+  static unsigned eq(Reg a, Reg b) { return unsigned(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+};
+
+template<>
+struct Lanes<Isa::Sse2, Kind::Double> {
+  using Reg = __m128d;
+  static constexpr size_t width = 2;
+
+  static Reg load(const void *p) { return _mm_loadu_pd(static_cast<const double *>(p)); }
+  static void store(void *p, Reg a) { _mm_storeu_pd(static_cast<double *>(p), a); }
+  static Reg set1(double x) { return _mm_set1_pd(x); }
+  static Reg add(Reg a, Reg b) { return _mm_add_pd(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm_mul_pd(a, b); }
+  static Reg min(Reg a, Reg b) { return _mm_min_pd(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm_max_pd(a, b); }
+  static unsigned eq(Reg a, Reg b) { return unsigned(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+};
+
+#endif
+
+#if defined(__AVX2__)
+
+template<size_t Size>
+struct Avx2Integer {
+  using Reg = __m256i;
+  static constexpr size_t width = 32 / Size;
+
+  static Reg load(const void *p) {
+    return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+  }
+  static void store(void *p, Reg a) {
+    _mm256_storeu_si256(static_cast<__m256i *>(p), a);
+  }
+  static unsigned eq(Reg a, Reg b) {
+    if constexpr (Size == 4) {
+      return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))));
+    } else {
+      return unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b))));
+    }
+  }
+};
+
+template<>
+struct Lanes<Isa::Avx2, Kind::Signed32> : Avx2Integer<4> {
+  static Reg set1(int32_t x) { return _mm256_set1_epi32(x); }
+  static Reg add(Reg a, Reg b) { return _mm256_add_epi32(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm256_mullo_epi32(a, b); }
+  static Reg min(Reg a, Reg b) { return _mm256_min_epi32(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm256_max_epi32(a, b); }
+};
+
+template<>
+struct Lanes<Isa::Avx2, Kind::Unsigned32> : Avx2Integer<4> {
+  static Reg set1(uint32_t x) { return _mm256_set1_epi32(int32_t(x)); }
+  static Reg add(Reg a, Reg b) { return _mm256_add_epi32(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm256_mullo_epi32(a, b); }
+  static Reg min(Reg a, Reg b) { return _mm256_min_epu32(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm256_max_epu32(a, b); }
+};
+
+template<>
+struct Lanes<Isa::Avx2, Kind::Signed64> : Avx2Integer<8> {
+  static Reg set1(int64_t x) { return _mm256_set1_epi64x(x); }
+  static Reg add(Reg a, Reg b) { return _mm256_add_epi64(a, b); }
+  static Reg min(Reg a, Reg b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+  }
+  static Reg max(Reg a, Reg b) {
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+  }
+};
+
+template<>
+struct Lanes<Isa::Avx2, Kind::Unsigned64> : Avx2Integer<8> {
+  static Reg set1(uint64_t x) { return _mm256_set1_epi64x(int64_t(x)); }
+  static Reg add(Reg a, Reg b) { return _mm256_add_epi64(a, b); }
+  static Reg min(Reg a, Reg b) {
+    return _mm256_blendv_epi8(a, b, greater(a, b));
+  }
+  static Reg max(Reg a, Reg b) {
+    return _mm256_blendv_epi8(b, a, greater(a, b));
+  }
+
+ private:
+  /**
+   * Unsigned comparison, done as a signed one with the sign bits flipped
+   */
+  static Reg greater(Reg a, Reg b) {
+    Reg sign = _mm256_set1_epi64x(INT64_MIN);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign),
+                              _mm256_xor_si256(b, sign));
+  }
+};
+
+template<>
+struct Lanes<Isa::Avx2, Kind::Float> {
+  using Reg = __m256;
+  static constexpr size_t width = 8;
+
+  static Reg load(const void *p) { return _mm256_loadu_ps(static_cast<const float *>(p)); }
+  static void store(void *p, Reg a) { _mm256_storeu_ps(static_cast<float *>(p), a); }
+  static Reg set1(float x) { return _mm256_set1_ps(x); }
+  static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+  static Reg min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+  static unsigned eq(Reg a, Reg b) {
+    return unsigned(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+  }
+};
+
+template<>
+struct Lanes<Isa::Avx2, Kind::Double> {
+  using Reg = __m256d;
+  static constexpr size_t width = 4;
+
+  static Reg load(const void *p) { return _mm256_loadu_pd(static_cast<const double *>(p)); }
+  static void store(void *p, Reg a) { _mm256_storeu_pd(static_cast<double *>(p), a); }
+  static Reg set1(double x) { return _mm256_set1_pd(x); }
+  static Reg add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+  static Reg min(Reg a, Reg b) { return _mm256_min_pd(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm256_max_pd(a, b); }
+  static unsigned eq(Reg a, Reg b) {
+    return unsigned(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+  }
+};
+
+#endif
+
+#if defined(__AVX512F__)
+
+template<size_t Size>
+struct Avx512Integer {
+  using Reg = __m512i;
+  static constexpr size_t width = 64 / Size;
+
+  static Reg load(const void *p) { return _mm512_loadu_si512(p); }
+  static void store(void *p, Reg a) { _mm512_storeu_si512(p, a); }
+  static unsigned eq(Reg a, Reg b) {
+    if constexpr (Size == 4) {
+      return _mm512_cmpeq_epi32_mask(a, b);
+    } else {
+      return _mm512_cmpeq_epi64_mask(a, b);
+    }
+  }
+};
+
+template<>
+struct Lanes<Isa::Avx512, Kind::Signed32> : Avx512Integer<4> {
+  static Reg set1(int32_t x) { return _mm512_set1_epi32(x); }
+  static Reg add(Reg a, Reg b) { return _mm512_add_epi32(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm512_mullo_epi32(a, b); }
+  static Reg min(Reg a, Reg b) { return _mm512_min_epi32(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm512_max_epi32(a, b); }
+};
+
+template<>
+struct Lanes<Isa::Avx512, Kind::Unsigned32> : Avx512Integer<4> {
+  static Reg set1(uint32_t x) { return _mm512_set1_epi32(int32_t(x)); }
+  static Reg add(Reg a, Reg b) { return _mm512_add_epi32(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm512_mullo_epi32(a, b); }
+  static Reg min(Reg a, Reg b) { return _mm512_min_epu32(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm512_max_epu32(a, b); }
+};
+
+template<>
+struct Lanes<Isa::Avx512, Kind::Signed64> : Avx512Integer<8> {
+  static Reg set1(int64_t x) { return _mm512_set1_epi64(x); }
+  static Reg add(Reg a, Reg b) { return _mm512_add_epi64(a, b); }
+#if defined(__AVX512DQ__)
+  static Reg mul(Reg a, Reg b) { return _mm512_mullo_epi64(a, b); }
+#endif
+  static Reg min(Reg a, Reg b) { return _mm512_min_epi64(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm512_max_epi64(a, b); }
+};
+
+template<>
+struct Lanes<Isa::Avx512, Kind::Unsigned64> : Avx512Integer<8> {
+  static Reg set1(uint64_t x) { return _mm512_set1_epi64(int64_t(x)); }
+  static Reg add(Reg a, Reg b) { return _mm512_add_epi64(a, b); }
+#if defined(__AVX512DQ__)
+  static Reg mul(Reg a, Reg b) { return _mm512_mullo_epi64(a, b); }
+#endif
+  static Reg min(Reg a, Reg b) { return _mm512_min_epu64(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm512_max_epu64(a, b); }
+};
+
+template<>
+struct Lanes<Isa::Avx512, Kind::Float> {
+  using Reg = __m512;
+  static constexpr size_t width = 16;
+
+  static Reg load(const void *p) { return _mm512_loadu_ps(p); }
+  static void store(void *p, Reg a) { _mm512_storeu_ps(p, a); }
+  static Reg set1(float x) { return _mm512_set1_ps(x); }
+  static Reg add(Reg a, Reg b) { return _mm512_add_ps(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm512_mul_ps(a, b); }
+  static Reg min(Reg a, Reg b) { return _mm512_min_ps(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm512_max_ps(a, b); }
+  static unsigned eq(Reg a, Reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+};
+
+template<>
+struct Lanes<Isa::Avx512, Kind::Double> {
+  using Reg = __m512d;
+  static constexpr size_t width = 8;
+
+  static Reg load(const void *p) { return _mm512_loadu_pd(p); }
+  static void store(void *p, Reg a) { _mm512_storeu_pd(p, a); }
+  static Reg set1(double x) { return _mm512_set1_pd(x); }
+  static Reg add(Reg a, Reg b) { return _mm512_add_pd(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm512_mul_pd(a, b); }
+  static Reg min(Reg a, Reg b) { return _mm512_min_pd(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm512_max_pd(a, b); }
+  static unsigned eq(Reg a, Reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+};
+
+#endif
+
+}
+
+}
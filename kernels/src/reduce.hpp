@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace colex::kernel {
+
+/**
+ * True if there are reduction kernels for elements of type `T`
+ */
+template<typename T>
+constexpr bool has_kernels_v =
+        std::is_same_v<T, int> || std::is_same_v<T, unsigned>
+        || std::is_same_v<T, long> || std::is_same_v<T, unsigned long>
+        || std::is_same_v<T, long long> || std::is_same_v<T, unsigned long long>
+        || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/**
+ * The sum of `xs[0..n)`. Integers wrap around on overflow.
+ * Floating point elements are added in an unspecified order.
+ */
+template<typename T>
+T sum(const T *xs, size_t n);
+
+/**
+ * The product of `xs[0..n)`. Integers wrap around on overflow.
+ * Floating point elements are multiplied in an unspecified order.
+ */
+template<typename T>
+T product(const T *xs, size_t n);
+
+/**
+ * The smallest of `xs[0..n)`. Requires that `n > 0`.
+ * The result is unspecified if `xs` contains NaN.
+ */
+template<typename T>
+T min(const T *xs, size_t n);
+
+/**
+ * The largest of `xs[0..n)`. Requires that `n > 0`.
+ * The result is unspecified if `xs` contains NaN.
+ */
+template<typename T>
+T max(const T *xs, size_t n);
+
+/**
+ * The smallest and the largest of `xs[0..n)`. Requires that `n > 0`.
+ * The result is unspecified if `xs` contains NaN.
+ */
+template<typename T>
+std::pair<T, T> minmax(const T *xs, size_t n);
+
+}
@@ -0,0 +1,7 @@
+#include "impl.hpp"
+
+namespace colex::kernel {
+
+const Table &scalar_table() { return table_for<Isa::Scalar>(); }
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+namespace colex::kernel {
+
+/**
+ * The number of elements in `xs[0..n)` that are equal to `value`
+ */
+template<typename T>
+size_t count(const T *xs, size_t n, T value);
+
+/**
+ * The index of the first element in `xs[0..n)` that
+ * is equal to `value`, or `n` if there is none
+ */
+template<typename T>
+size_t find(const T *xs, size_t n, T value);
+
+}
@@ -0,0 +1,9 @@
+#include "impl.hpp"
+
+namespace colex::kernel {
+
+#if defined(__SSE2__)
+const Table &sse2_table() { return table_for<Isa::Sse2>(); }
+#endif
+
+}
@@ -0,0 +1,51 @@
+#include "stream.hpp"
+#include "isa.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace colex::kernel {
+
+void stream_copy(void *out, const void *in, size_t bytes) {
+#if defined(__SSE2__)
+  // Short copies aren't worth the fence
+  if (active_isa() != Isa::Scalar && bytes >= 1024) {
+    auto *dst = static_cast<char *>(out);
+    auto *src = static_cast<const char *>(in);
+
+    size_t head = (16 - reinterpret_cast<std::uintptr_t>(dst) % 16) % 16;
+    std::memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    bytes -= head;
+
+    for (; bytes >= 64; bytes -= 64, dst += 64, src += 64) {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+      __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16));
+      __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 32));
+      __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 48));
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst), a);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 16), b);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 32), c);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 48), d);
+    }
+
+    for (; bytes >= 16; bytes -= 16, dst += 16, src += 16) {
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst),
+                       _mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+    }
+
+    _mm_sfence();
+    std::memcpy(dst, src, bytes);
+    return;
+  }
+#endif
+
+  std::memcpy(out, in, bytes);
+}
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace colex::kernel {
+
+/**
+ * Copies `bytes` bytes from `in` to `out` like `std::memcpy`, but with
+ * non-temporal stores where the active instruction set has them. The
+ * copy then bypasses the caches, which keeps large outputs that aren't
+ * read again soon from evicting the working set. The ranges must not
+ * overlap.
+ */
+void stream_copy(void *out, const void *in, size_t bytes);
+
+}
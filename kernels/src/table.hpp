@@ -0,0 +1,44 @@
+#pragma once
+
+#include "isa.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace colex::kernel {
+
+/**
+ * The kernels for elements of type `T` on one instruction set
+ */
+template<typename T>
+struct Kernels {
+  T (*sum)(const T *, size_t);
+  T (*product)(const T *, size_t);
+  T (*min)(const T *, size_t);
+  T (*max)(const T *, size_t);
+  std::pair<T, T> (*minmax)(const T *, size_t);
+  size_t (*count)(const T *, size_t, T);
+  size_t (*find)(const T *, size_t, T);
+  size_t (*compress)(const T *, const bool *, size_t, T *);
+};
+
+/**
+ * All kernels on one instruction set
+ */
+using Table = std::tuple<Kernels<int>, Kernels<unsigned>,
+                         Kernels<long>, Kernels<unsigned long>,
+                         Kernels<long long>, Kernels<unsigned long long>,
+                         Kernels<float>, Kernels<double>>;
+
+/**
+ * The kernels of each instruction set. Each is defined in a translation
+ * unit compiled for that instruction set, and must only be called
+ * if the host supports it.
+ */
+const Table &scalar_table();
+const Table &sse2_table();
+const Table &avx2_table();
+const Table &avx512_table();
+
+}
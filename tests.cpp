@@ -3,6 +3,16 @@
 
 #include "colex.hpp"
 
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <set>
+#include <string>
+
 using namespace colex;
 
 struct MoveInt {
@@ -136,6 +146,73 @@ TEST_CASE("flat_map") {
   CHECK(ys.size() == 10);
 }
 
+/**
+ * Counts the instances alive, to check that none leak or are destroyed twice
+ */
+struct Tracked {
+  static inline int alive = 0;
+
+  Tracked(int x) : x(x) { ++alive; }
+  Tracked(const Tracked &other) : x(other.x) { ++alive; }
+  Tracked(Tracked &&other) noexcept : x(other.x) { ++alive; }
+  ~Tracked() { --alive; }
+
+  int x;
+};
+
+TEST_CASE("inline") {
+  auto spaced = iter(std::vector<char>{'a', 'b'})
+              | flat_map([](char x) { return pair_of(x, ' '); })
+              | collect<std::vector>();
+  CHECK(spaced == std::vector<char>{'a', ' ', 'b', ' '});
+
+  auto tokens = iter(std::vector<int>{1, 2, 3})
+              | flat_map([](int x) {
+                  iterator::Inline<int, 4> out;
+                  for (int i = 0; i < x; ++i) { out.push_back(x); }
+                  return out;
+                })
+              | collect<std::vector>();
+  CHECK(tokens == std::vector<int>{1, 2, 2, 3, 3, 3});
+
+  auto xs = iter_inline<4>({1, 2, 3});
+  CHECK(xs.size_hint().lower == 3);
+  CHECK(xs.data()[2] == 3);
+  CHECK((std::move(xs) | sum()) == 6);
+  CHECK_THROWS_AS(iter_inline<2>({1, 2, 3}), std::length_error);
+  CHECK((once(std::string("a")) | collect<std::vector>()) == std::vector<std::string>{"a"});
+  CHECK((iter_inline<8>({1, 2, 3, 4, 5}) | drop(1) | take(2) | collect<std::vector>())
+        == std::vector<int>{2, 3});
+
+  {
+    auto ts = iter_inline<4>({Tracked(1), Tracked(2), Tracked(3)});
+    CHECK(Tracked::alive == 3);
+    CHECK(ts.next().value().x == 1);
+    CHECK(Tracked::alive == 2);
+
+    auto moved = std::move(ts);
+    moved.truncate(1);
+    CHECK(moved.next().value().x == 2);
+    CHECK_FALSE(moved.next().has_value());
+  }
+  CHECK(Tracked::alive == 0);
+
+  {
+    auto pairs = iter(std::vector<int>{1, 2, 3})
+               | flat_map([](int x) { return pair_of(Tracked(x), Tracked(-x)); });
+    int first = 0;
+    int seen = 0;
+    CHECK_FALSE(pairs.for_each_while([&](Tracked t) {
+      first += t.x;
+      return ++seen < 3;
+    }));
+    CHECK(first == 1 - 1 + 2);
+    CHECK(pairs.next().value().x == -2);
+    CHECK(pairs.next().value().x == 3);
+  }
+  CHECK(Tracked::alive == 0);
+}
+
 TEST_CASE("enumerate") {
   auto ys = iter(move_int_vec()) | enumerate() | collect<std::vector>();
 
@@ -269,6 +346,122 @@ TEST_CASE("window") {
   CHECK(ys.size() == 2);
 }
 
+TEST_CASE("window views") {
+  std::vector<int> xs{1, 2, 3, 4, 5};
+
+  auto views = iter(xs) | window<3>();
+  CHECK(views.size_hint().upper == 3);
+  auto first = views.next().value();
+  CHECK(first.data() == xs.data());
+  auto second = views.next().value();
+  CHECK(second.data() == xs.data() + 1);
+  CHECK(first[2] == 3);
+
+  auto sums = range(0, 10) | window<4>()
+            | map([](auto w) { return std::accumulate(w.begin(), w.end(), 0); })
+            | collect<std::vector>();
+  CHECK(sums == std::vector<int>{6, 10, 14, 18, 22, 26, 30});
+
+  std::list<int> l{1, 2, 3, 4};
+  auto ring = iter(l) | window<2>();
+  CHECK(ring.size_hint().lower == 3);
+  auto a = ring.next().value();
+  CHECK(a[0] == 1);
+  CHECK(a[1] == 2);
+  CHECK(ring.size_hint().lower == 2);
+  auto b = ring.next().value();
+  CHECK(b.front() == 2);
+  CHECK(b.back() == 3);
+  std::array<int, 2> c = ring.next().value();
+  CHECK(c == std::array<int, 2>{3, 4});
+  CHECK_FALSE(ring.next().has_value());
+
+  CHECK_FALSE((iter(xs) | window<6>()).next().has_value());
+  CHECK_FALSE((range(0, 2) | window<3>()).next().has_value());
+}
+
+TEST_CASE("dynamic window") {
+  auto to_vector = [](auto w) { return std::vector<int>(w.begin(), w.end()); };
+  using Windows = std::vector<std::vector<int>>;
+
+  std::vector<int> xs{0, 1, 2, 3, 4, 5, 6};
+  std::list<int> ys(xs.begin(), xs.end());
+
+  auto contiguous = iter(xs) | window(3, 2);
+  CHECK(contiguous.size_hint().upper == 3);
+  CHECK(contiguous.next().value().data() == xs.data());
+  CHECK((std::move(contiguous) | map(to_vector) | collect<std::vector>())
+        == Windows{{2, 3, 4}, {4, 5, 6}});
+
+  CHECK((iter(ys) | window(3, 2) | map(to_vector) | collect<std::vector>())
+        == Windows{{0, 1, 2}, {2, 3, 4}, {4, 5, 6}});
+
+  auto tumbling = iter(ys) | window(2, 2);
+  CHECK(tumbling.size_hint().lower == 3);
+  CHECK((std::move(tumbling) | map(to_vector) | collect<std::vector>())
+        == Windows{{0, 1}, {2, 3}, {4, 5}});
+
+  CHECK((iter(ys) | window(2, 3) | map(to_vector) | collect<std::vector>())
+        == Windows{{0, 1}, {3, 4}});
+  CHECK((range(0, 7) | window(2, 3) | map(to_vector) | collect<std::vector>())
+        == Windows{{0, 1}, {3, 4}});
+  CHECK((iter(xs) | window(2, 3) | map(to_vector) | collect<std::vector>())
+        == Windows{{0, 1}, {3, 4}});
+
+  auto sliding = range(0, 100) | window(10) | map([](auto w) { return w.back() - w.front(); })
+               | collect<std::vector>();
+  CHECK(sliding.size() == 91);
+  CHECK(std::all_of(sliding.begin(), sliding.end(), [](int d) { return d == 9; }));
+
+  auto strings = iter({std::string("a"), std::string("b"), std::string("c")})
+               | window(2) | map([](auto w) { return w[0] + w[1]; })
+               | collect<std::vector>();
+  CHECK(strings == std::vector<std::string>{"ab", "bc"});
+
+  CHECK_FALSE((iter(ys) | window(8, 1)).next().has_value());
+
+  CHECK((iter(xs) | window(0) | count()) == 7);
+  CHECK((iter(ys) | window(0, 0) | map(to_vector) | collect<std::vector>())
+        == Windows{{0}, {1}, {2}, {3}, {4}, {5}, {6}});
+}
+
+TEST_CASE("rolling") {
+  std::vector<int> xs{4, 1, 3, 5, 2, 2, 6};
+
+  auto sums = iter(xs) | rolling_sum(3);
+  CHECK(sums.size_hint().lower == 5);
+  CHECK(sums.next().value() == 8);
+  CHECK(sums.size_hint().upper == 4);
+  CHECK((std::move(sums) | collect<std::vector>()) == std::vector<int>{9, 10, 9, 10});
+
+  CHECK((iter(xs) | rolling_mean(2) | collect<std::vector>())
+        == std::vector<double>{2.5, 2, 4, 3.5, 2, 4});
+  CHECK((iter(xs) | rolling_min(3) | collect<std::vector>())
+        == std::vector<int>{1, 1, 2, 2, 2});
+  CHECK((iter(xs) | rolling_max(3) | collect<std::vector>())
+        == std::vector<int>{4, 5, 5, 5, 6});
+  CHECK((iter(xs) | rolling_max(1) | collect<std::vector>()) == xs);
+  CHECK((iter(xs) | rolling_min(0) | collect<std::vector>()) == xs);
+
+  CHECK_FALSE((iter(xs) | rolling_sum(8)).next().has_value());
+  CHECK((iter(xs) | rolling_min(8) | collect<std::vector>()).empty());
+  CHECK((iter(xs) | rolling_sum(7) | collect<std::vector>()) == std::vector<int>{23});
+
+  auto strings = iter({std::string("b"), std::string("a"), std::string("c")})
+               | rolling_min(2) | collect<std::vector>();
+  CHECK(strings == std::vector<std::string>{"a", "a"});
+
+  auto naive = range(0, 1000) | map([](int x) { return (x * 37) % 101; })
+             | window(50) | map([](auto w) { return *std::max_element(w.begin(), w.end()); })
+             | collect<std::vector>();
+  auto rolling = range(0, 1000) | map([](int x) { return (x * 37) % 101; })
+               | rolling_max(50) | collect<std::vector>();
+  CHECK(rolling == naive);
+
+  CHECK((range(0, 10) | rolling_sum(4) | take(2) | collect<std::vector>())
+        == std::vector<int>{6, 10});
+}
+
 TEST_CASE("conversion") {
   auto xs = move_int_vec();
   xs.emplace_back(3);
@@ -457,6 +650,41 @@ TEST_CASE("chunk") {
   CHECK(ys.size() == 3);
 }
 
+TEST_CASE("contiguous chunks") {
+  std::vector<int> xs{1, 2, 3, 4, 5, 6, 7};
+
+  auto chunks = iter(xs) | chunk(3);
+  static_assert(std::is_same_v<decltype(chunks.next())::value_type, decltype(iter(xs))>);
+
+  auto first = chunks.next().value();
+  CHECK(first.data() == xs.data());
+  CHECK(first.size_hint().upper == 3);
+  CHECK(chunks.next().value().data() == xs.data() + 3);
+
+  auto last = chunks.next().value();
+  CHECK(last.size_hint().upper == 1);
+  CHECK(last.next().value() == 7);
+  CHECK_FALSE(chunks.next().has_value());
+
+  CHECK((iter(xs.data(), xs.size()) | chunk_map(3, sum()) | collect<std::vector>())
+        == std::vector<int>{6, 15, 7});
+  CHECK((iter(xs) | chunk_map(2, max()) | collect<std::vector>())
+        == std::vector<std::optional<int>>{2, 4, 6, 7});
+  CHECK((range(0, 10) | chunk_map(4, sum()) | collect<std::vector>())
+        == std::vector<int>{6, 22, 17});
+  CHECK_FALSE((iter(xs) | chunk(0)).next().has_value());
+}
+
+TEST_CASE("chunks of size 0") {
+  std::vector<int> xs{1, 2, 3};
+
+  CHECK((iter(xs) | chunk(0)).size_hint().upper == 0);
+  CHECK((iter(xs) | chunk(0) | count()) == 0);
+  CHECK((iter(xs) | chunk_map(0, sum()) | collect<std::vector>()).empty());
+  CHECK((iter(std::list<int>{1, 2}) | chunk_map(0, fold(0, std::plus())) | collect<std::vector>())
+                .empty());
+}
+
 TEST_CASE("partition") {
   std::vector<size_t> partition_sizes{2, 3};
   std::vector<int> xs{1, 2, 3, 4, 5, 6, 7};
@@ -469,6 +697,16 @@ TEST_CASE("partition") {
   CHECK(ys[1] == 12);
   CHECK(ys[2] == 13);
   CHECK(ys.size() == 3);
+
+  auto empty_first = iter(std::vector<int>{1, 2, 3}) | partition({0, 2});
+  CHECK(empty_first.size_hint().lower == 0);
+  CHECK((std::move(empty_first) | count()) == 0);
+
+  auto split = iter(xs) | partition({2, 0});
+  CHECK(split.size_hint().lower == 1);
+  CHECK(split.next().has_value());
+  CHECK(split.size_hint().lower == 0);
+  CHECK_FALSE(split.next().has_value());
 }
 
 TEST_CASE("partition_map") {
@@ -482,6 +720,50 @@ TEST_CASE("partition_map") {
   CHECK(ys[1] == 12);
   CHECK(ys[2] == 13);
   CHECK(ys.size() == 3);
+
+  auto empty_first = iter(xs) | partition_map({0, 2}, sum());
+  CHECK(empty_first.size_hint().lower == 0);
+  CHECK_FALSE(empty_first.next().has_value());
+}
+
+TEST_CASE("par partition map") {
+  executor::ThreadPool pool(4);
+
+  std::vector<size_t> partition_sizes{2, 3};
+  std::vector<int> xs{1, 2, 3, 4, 5, 6, 7};
+
+  auto ys = iter(xs) | par_partition_map(partition_sizes, sum(), pool);
+  CHECK(ys.size_hint().upper == 3);
+  CHECK((std::move(ys) | collect<std::vector>()) == std::vector<int>{3, 12, 13});
+
+  std::list<int> zs(xs.begin(), xs.end());
+  CHECK((iter(zs) | par_partition_map(partition_sizes, sum(), pool) | collect<std::vector>())
+        == std::vector<int>{3, 12, 13});
+  CHECK((iter(xs) | par_partition_map({2, 10, 4}, sum()) | collect<std::vector>())
+        == std::vector<int>{3, 25});
+  CHECK((iter(zs) | par_partition_map({2, 10, 4}, sum()) | collect<std::vector>())
+        == std::vector<int>{3, 25});
+  CHECK((iter(xs) | par_partition_map({2, 0, 4}, sum()) | collect<std::vector>())
+        == std::vector<int>{3});
+  CHECK((iter(xs) | par_partition_map({0, 4}, sum(), pool)).size_hint().lower == 0);
+  CHECK((iter(zs) | par_partition_map({0, 4}, sum(), pool)).size_hint().lower == 0);
+  CHECK((iter(zs) | par_partition_map({0, 4}, sum(), pool) | collect<std::vector>()).empty());
+  CHECK((iter(xs) | par_partition_map({}, sum()) | collect<std::vector>())
+        == std::vector<int>{28});
+
+  std::vector<size_t> uneven;
+  for (size_t i = 0; i < 200; ++i) { uneven.push_back(i % 17 == 0 ? 5000 : i); }
+  auto sizes = iter(uneven) | fold(size_t(0), std::plus<>());
+
+  auto lengths = range(size_t(0), sizes)
+               | par_partition_map(uneven, fold(size_t(0), [](size_t n, size_t) { return n + 1; }), pool)
+               | collect<std::vector>();
+  CHECK(lengths == uneven);
+
+  auto sequential = range(0, 100000) | partition_map(uneven, sum()) | collect<std::vector>();
+  auto parallel = range(0, 100000) | par_partition_map(uneven, sum(), pool)
+                | collect<std::vector>();
+  CHECK(parallel == sequential);
 }
 
 TEST_CASE("flatten") {
@@ -547,4 +829,753 @@ TEST_CASE("scan") {
   CHECK(ys[3] == 6);
   CHECK(ys[4] == 10);
   CHECK(ys.size() == 5);
-}
\ No newline at end of file
+}
+
+TEST_CASE("size hint") {
+  std::vector<int> xs{1, 2, 3, 4, 5};
+
+  auto exact = iter(xs) | map([](int x) { return 2 * x; }) | enumerate();
+  CHECK(exact.size_hint().lower == 5);
+  CHECK(exact.size_hint().upper == 5);
+
+  auto filtered = iter(xs) | filter([](int x) { return x < 3; });
+  CHECK(filtered.size_hint().lower == 0);
+  CHECK(filtered.size_hint().upper == 5);
+
+  auto zipped = zip(range(0, 3), open_range(0, 1));
+  CHECK(zipped.size_hint().lower == 3);
+  CHECK(zipped.size_hint().upper == 3);
+
+  auto concatenated = concat(iter(xs) | take(2), iter(xs) | drop(4));
+  CHECK(concatenated.size_hint().lower == 3);
+  CHECK(concatenated.size_hint().upper == 3);
+
+  auto chunked = iter(xs) | chunk(2);
+  CHECK(chunked.size_hint().lower == 3);
+  CHECK(chunked.size_hint().upper == 3);
+
+  auto ys = range(0, 10, 3) | collect<std::vector>();
+  CHECK(ys.capacity() == 4);
+  CHECK(ys.size() == 4);
+}
+
+TEST_CASE("node extraction") {
+  std::map<MoveInt, int> moved;
+  moved.emplace(2, 20);
+  moved.emplace(1, 10);
+
+  auto pairs = iter(std::move(moved))
+             | map([](std::pair<MoveInt, int> x) { return x.first.x + x.second; })
+             | collect<std::vector>();
+  CHECK(pairs == std::vector<int>{11, 22});
+
+  std::set<MoveInt> keys;
+  keys.emplace(3);
+  keys.emplace(1);
+  CHECK((iter(std::move(keys)) | map([](MoveInt x) { return x.x; }) | collect<std::vector>())
+        == std::vector<int>{1, 3});
+
+  std::multimap<std::string, int> multi{{"a", 1}, {"b", 2}, {"a", 3}};
+  CHECK((iter(multi) | map([](auto x) { return x.second; }) | collect<std::vector>())
+        == std::vector<int>{1, 3, 2});
+  CHECK((iter(std::move(multi)) | collect<std::map>()) == std::map<std::string, int>{{"a", 1}, {"b", 2}});
+
+  std::unordered_set<std::string> words{"x", "y"};
+  CHECK((iter(std::move(words)) | collect<std::set>()) == std::set<std::string>{"x", "y"});
+
+  std::map<std::string, int> source{{"one", 1}, {"two", 2}};
+  const std::string *first_key = &source.begin()->first;
+  auto nodes = iter_nodes(std::move(source));
+  CHECK(nodes.size_hint().upper == 2);
+
+  auto relinked = std::move(nodes) | collect<std::map>();
+  CHECK(relinked == std::map<std::string, int>{{"one", 1}, {"two", 2}});
+  CHECK(&relinked.begin()->first == first_key);
+
+  std::unordered_map<std::string, int> hashed{{"one", 1}, {"two", 2}};
+  auto ordered = iter_nodes(std::move(hashed)) | collect<std::map>();
+  CHECK(ordered == std::map<std::string, int>{{"one", 1}, {"two", 2}});
+
+  std::set<int> small{1, 2, 3};
+  const int *first_value = &*small.begin();
+  auto same = iter_nodes(std::move(small)) | collect<std::set>();
+  CHECK(&*same.begin() == first_value);
+  CHECK((iter_nodes(std::move(same)) | collect<std::unordered_set>()) == std::unordered_set<int>{1, 2, 3});
+}
+
+TEST_CASE("sorted") {
+  std::set<int> xs{5, 1, 3};
+  std::map<std::string, int> ys{{"b", 2}, {"a", 1}};
+
+  static_assert(iterator::is_sorted_v<decltype(iter(xs))>);
+  static_assert(iterator::is_sorted_v<decltype(iter(ys))>);
+  static_assert(iterator::is_sorted_v<decltype(iter(std::map<int, int>()))>);
+  auto positive = [](int x) { return x > 1; };
+  auto negate = [](int x) { return -x; };
+  static_assert(iterator::is_sorted_v<decltype(iter(xs) | filter(positive) | take(1))>);
+  static_assert(!iterator::is_sorted_v<decltype(iter(xs) | map(negate))>);
+  static_assert(!iterator::is_sorted_v<decltype(iter(std::unordered_set<int>()))>);
+
+  // Equal keys of a multimap keep their insertion order, so its pairs aren't sorted
+  std::multimap<int, int> multi{{1, 5}, {1, 2}, {1, 9}};
+  static_assert(iterator::is_sorted_v<decltype(iter(std::multiset<int>()))>);
+  static_assert(!iterator::is_sorted_v<decltype(iter(multi))>);
+  static_assert(!iterator::is_sorted_v<decltype(iter(std::multimap<int, int>()))>);
+  static_assert(!iterator::is_sorted_v<decltype(iter_nodes(std::multimap<int, int>()))>);
+  CHECK((iter(multi) | collect<std::set>())
+        == std::set<std::pair<int, int>>{{1, 2}, {1, 5}, {1, 9}});
+
+  CHECK((iter(xs) | drop(1) | collect<std::set>()) == std::set<int>{3, 5});
+  CHECK((iter(ys) | collect<std::map>()) == ys);
+
+  auto shuffled = iter({4, 1, 3, 1, 2}) | sorted();
+  static_assert(iterator::is_sorted_v<decltype(shuffled)>);
+  CHECK(shuffled.size_hint().upper == 5);
+  CHECK((std::move(shuffled) | collect<std::vector>()) == std::vector<int>{1, 1, 2, 3, 4});
+  CHECK((iter({4, 1, 3, 1, 2}) | sorted() | collect<std::set>()) == std::set<int>{1, 2, 3, 4});
+
+  auto pairs = iter({std::pair<int, int>(2, 0), std::pair<int, int>(1, 5), std::pair<int, int>(2, 1)})
+             | sorted() | collect<std::map>();
+  CHECK(pairs == std::map<int, int>{{1, 5}, {2, 0}});
+
+  CHECK((range(0, 5) | assume_sorted() | collect<std::set>()) == std::set<int>{0, 1, 2, 3, 4});
+  CHECK((iter({3, 1, 2}) | assume_sorted() | collect<std::set>()) == std::set<int>{1, 2, 3});
+  CHECK((range(0, 100) | assume_sorted() | drop(10) | count()) == 90);
+}
+
+TEST_CASE("flat containers") {
+  using container::flat_map;
+  using container::flat_set;
+
+  auto set = iter({5, 1, 3, 1, 5}) | collect<flat_set>();
+  static_assert(std::is_same_v<decltype(set), flat_set<int>>);
+  CHECK(std::vector<int>(set.begin(), set.end()) == std::vector<int>{1, 3, 5});
+  CHECK(set.contains(3));
+  CHECK_FALSE(set.contains(2));
+  CHECK(set.find(4) == set.end());
+  CHECK(*set.lower_bound(2) == 3);
+  CHECK(set.insert(2).second);
+  CHECK_FALSE(set.insert(3).second);
+  CHECK(set.size() == 4);
+
+  auto borrowed = iter(set);
+  static_assert(iterator::is_contiguous_v<decltype(borrowed)>);
+  static_assert(iterator::is_sorted_v<decltype(borrowed)>);
+  CHECK(borrowed.data() == set.data());
+  CHECK((std::move(borrowed) | sum()) == 11);
+  CHECK((iter(set) | collect<std::set>()) == std::set<int>{1, 2, 3, 5});
+  CHECK((iter(std::move(set)) | collect<std::vector>()) == std::vector<int>{1, 2, 3, 5});
+
+  CHECK((range(0, 10) | assume_sorted() | map([](int x) { return x / 3; }) | collect<flat_set>())
+        == flat_set<int>(std::vector<int>{0, 1, 2, 3}));
+
+  std::vector<std::pair<std::string, int>> rows{{"b", 2}, {"a", 1}, {"b", 3}, {"c", 4}};
+  auto index = iter(rows) | collect<flat_map>();
+  static_assert(std::is_same_v<decltype(index), flat_map<std::string, int>>);
+  CHECK(index.size() == 3);
+  CHECK(index.at("b") == 2);
+  CHECK(index.count("c") == 1);
+  CHECK_FALSE(index.contains("d"));
+  CHECK_THROWS_AS((void) index.at("d"), std::out_of_range);
+  index.at("a") = 10;
+  CHECK(index.find("a")->second == 10);
+
+  std::map<std::string, int> ordered{{"x", 1}, {"y", 2}};
+  CHECK((iter(ordered) | collect<flat_map>()).size() == 2);
+  CHECK((iter(index) | collect<std::map>())
+        == std::map<std::string, int>{{"a", 10}, {"b", 2}, {"c", 4}});
+  CHECK((iter(std::move(index)) | map([](auto x) { return x.second; }) | collect<std::vector>())
+        == std::vector<int>{10, 2, 4});
+
+  std::multimap<int, int> multi{{1, 5}, {1, 2}, {1, 9}, {0, 3}};
+  auto pairs = iter(multi) | collect<flat_set>();
+  CHECK(pairs.size() == 4);
+  CHECK(pairs.contains({1, 2}));
+  CHECK(*pairs.begin() == std::pair<int, int>(0, 3));
+  CHECK((iter(std::move(multi)) | collect<flat_set>()) == pairs);
+
+  auto first = iter(std::multimap<int, int>{{1, 5}, {1, 2}, {0, 3}}) | collect<flat_map>();
+  CHECK(first.size() == 2);
+  CHECK(first.at(1) == 5);
+}
+
+struct ModHash {
+  size_t operator()(int x) const { return size_t(x % 7); }
+};
+
+struct InsertOnly {
+  void insert(int x) { items.push_back(x); }
+
+  std::vector<int> items;
+};
+
+TEST_CASE("collect as and into") {
+  auto hashed = range(0, 20) | map([](int x) { return std::pair(x, x * x); })
+              | collect_as<std::unordered_map<int, int, ModHash>>();
+  CHECK(hashed.size() == 20);
+  CHECK(hashed.at(9) == 81);
+
+  auto descending = iter({3, 1, 2}) | collect_as<std::set<int, std::greater<>>>();
+  CHECK(std::vector<int>(descending.begin(), descending.end()) == std::vector<int>{3, 2, 1});
+  CHECK((iter(std::set<int>{1, 2}) | collect_as<std::set<int, std::greater<>>>()).size() == 2);
+
+  auto queue = range(0, 3) | collect_as<std::deque<int>>();
+  CHECK(queue == std::deque<int>{0, 1, 2});
+
+  std::array<std::byte, 1024> buffer;
+  std::pmr::monotonic_buffer_resource pool(buffer.data(), buffer.size());
+  std::pmr::vector<int> pooled(&pool);
+  range(0, 10) | collect_into(pooled);
+  CHECK(pooled.size() == 10);
+  CHECK(pooled.get_allocator().resource() == &pool);
+
+  std::vector<int> xs{1, 2};
+  auto &same = iter({3, 4}) | collect_into(xs);
+  CHECK(&same == &xs);
+  range(5, 7) | collect_into(xs);
+  CHECK(xs == std::vector<int>{1, 2, 3, 4, 5, 6});
+
+  std::map<std::string, int> ages{{"a", 1}};
+  std::map<std::string, int> more{{"b", 2}, {"a", 5}};
+  iter_nodes(std::move(more)) | collect_into(ages);
+  CHECK(ages == std::map<std::string, int>{{"a", 1}, {"b", 2}});
+
+  InsertOnly custom;
+  range(0, 3) | collect_into(custom);
+  CHECK(custom.items == std::vector<int>{0, 1, 2});
+}
+
+/**
+ * Counts the allocations it forwards to the default resource
+ */
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::get_default_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+  }
+
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+TEST_CASE("with resource") {
+  CountingResource counting;
+  CHECK(current_resource() == std::pmr::get_default_resource());
+
+  auto ys = with_resource(&counting, [] {
+    CHECK(current_resource() != std::pmr::get_default_resource());
+    return range(0, 3) | prepend({-2, -1}) | append({3, 4})
+           | flat_map([](int x) { return iter({x, x}); })
+           | collect_as<std::pmr::vector<int>>();
+  });
+
+  CHECK(ys.get_allocator().resource() == &counting);
+  CHECK(ys == std::pmr::vector<int>{-2, -2, -1, -1, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4});
+  // prepend, append, 7 inner lists and at least one for the result
+  CHECK(counting.allocations >= 10);
+  CHECK(current_resource() == std::pmr::get_default_resource());
+
+  CountingResource inner;
+  size_t before = counting.allocations;
+  size_t parts = with_resource(&counting, [&] {
+    with_resource(&inner, [] { return iter({1, 2, 3}) | sum(); });
+    CHECK(current_resource() == &counting);
+
+    return range(0, 10) | partition({3, 3}) | count();
+  });
+  CHECK(parts == 3);
+  CHECK(inner.allocations == 1);
+  CHECK(counting.allocations > before);
+
+  // Moving a list keeps its position, but assigning could switch resources
+  static_assert(!std::is_move_assignable_v<decltype(iter({1, 2}))>);
+  auto list = with_resource(&counting, [] { return iter({1, 2, 3}); });
+  CHECK(list.next() == 1);
+  auto moved = std::move(list);
+  CHECK((std::move(moved) | collect<std::vector>()) == std::vector<int>{2, 3});
+
+  std::array<std::byte, 4096> buffer;
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                            std::pmr::null_memory_resource());
+  auto lengths = with_resource(&arena, [] {
+    return iter({"a", "bb", "ccc"})
+           | map([](const char *s) { return std::pmr::string(s); })
+           | map([](const std::pmr::string &s) { return s.size(); })
+           | collect_as<std::pmr::vector<size_t>>();
+  });
+  CHECK(lengths == std::pmr::vector<size_t>{1, 2, 3});
+}
+
+TEST_CASE("write to") {
+  std::array<int, 8> out{};
+
+  CHECK((range(0, 5) | write_to(out.data(), out.size())) == 5);
+  CHECK(out == std::array<int, 8>{0, 1, 2, 3, 4, 0, 0, 0});
+  CHECK((range(10, 100) | write_to(out.data(), 3)) == 3);
+  CHECK(out[2] == 12);
+  CHECK((range(0, 5) | write_to(out.data(), 0)) == 0);
+
+  std::array<long, 4> wide{};
+  CHECK((range(0, 10) | write_to(wide.data(), wide.size())) == 4);
+  CHECK(wide == std::array<long, 4>{0, 1, 2, 3});
+
+  alignas(std::string) unsigned char raw[2 * sizeof(std::string)];
+  auto *strings = reinterpret_cast<std::string *>(raw);
+  CHECK((iter({std::string(100, 'a'), std::string(100, 'b'), std::string("c")})
+         | write_to(strings, 2)) == 2);
+  CHECK(strings[1] == std::string(100, 'b'));
+  std::destroy_n(strings, 2);
+
+  alignas(Tracked) unsigned char tracked_raw[4 * sizeof(Tracked)];
+  auto *tracked = reinterpret_cast<Tracked *>(tracked_raw);
+  auto throw_at_2 = [](int x) {
+    if (x == 2) { throw std::runtime_error("2"); }
+    return x;
+  };
+  CHECK_THROWS_AS(range(0, 4) | map(throw_at_2) | write_to(tracked, 4), std::runtime_error);
+  CHECK(Tracked::alive == 0);
+
+  std::vector<int> xs(5000);
+  std::iota(xs.begin(), xs.end(), 0);
+  std::vector<int> ys(6000, -1);
+
+  CHECK((iter(xs) | write_to(ys.data() + 1, 4999, Store::NonTemporal)) == 4999);
+  CHECK(std::equal(xs.begin(), xs.end() - 1, ys.begin() + 1));
+  CHECK(ys[0] == -1);
+  CHECK(ys[5000] == -1);
+
+  std::fill(ys.begin(), ys.end(), -1);
+  auto odd = [](int x) { return x % 2 == 1; };
+  CHECK((iter(xs) | filter(odd) | write_to(ys.data(), ys.size(), Store::NonTemporal)) == 2500);
+  CHECK(ys[2499] == 4999);
+  CHECK(ys[2500] == -1);
+
+  std::fill(ys.begin(), ys.end(), -1);
+  CHECK((range(0, 3000) | write_to(ys.data(), 1500, Store::NonTemporal)) == 1500);
+  CHECK(ys[1499] == 1499);
+  CHECK(ys[1500] == -1);
+}
+
+TEST_CASE("collect into reuses capacity") {
+  std::vector<int> xs(1000);
+  std::iota(xs.begin(), xs.end(), 0);
+
+  std::vector<int> out;
+  iter(xs) | collect_into(out);
+  const int *storage = out.data();
+
+  out.clear();
+  range(0, 1000) | collect_into(out);
+  CHECK(out.data() == storage);
+  CHECK(out == xs);
+
+  out.clear();
+  iter(xs.data(), 10) | collect_into(out);
+  iter(xs) | filter([](int x) { return x < 5; }) | collect_into(out);
+  CHECK(out.data() == storage);
+  CHECK(out.size() == 15);
+
+  std::vector<std::string> names{"a"};
+  iter(std::vector<std::string>{"b", "c"}) | collect_into(names);
+  CHECK(names == std::vector<std::string>{"a", "b", "c"});
+}
+
+TEST_CASE("range length") {
+  auto xs = range(0, 1000000000, 3);
+  CHECK(xs.size_hint().upper == 333333334);
+
+  CHECK((range(0, 1000000000) | drop(10) | take(5) | count()) == 5);
+  CHECK((range(0, 1000000000, 7) | count()) == 142857143);
+  CHECK((range(5, 5) | count()) == 0);
+  CHECK((range(0, 100) | filter([](int x) { return x % 3 == 0; }) | count()) == 34);
+  CHECK((iter(std::list<int>{1, 2, 3}) | count()) == 3);
+
+  auto edge = range(std::numeric_limits<int>::max() - 4, std::numeric_limits<int>::max(), 3)
+            | collect<std::vector>();
+  CHECK(edge == std::vector<int>{std::numeric_limits<int>::max() - 4,
+                                 std::numeric_limits<int>::max() - 1});
+
+  auto sum_of = [](auto begin, auto end, auto step) {
+    decltype(begin) total = 0;
+    for (auto x = begin; x < end; x += step) { total += x; }
+    return total;
+  };
+
+  CHECK((range(0, 100000) | fold(0LL, std::plus<>())) == 4999950000LL);
+  CHECK((range(0LL, 100000LL) | fold(7LL, std::plus<>())) == 4999950007LL);
+  CHECK((range(-50, 77, 4) | fold(0, std::plus<>())) == sum_of(-50, 77, 4));
+  CHECK((range(3u, 1000u, 7u) | sum()) == sum_of(3u, 1000u, 7u));
+  CHECK((range(1000, 2000) | drop(10) | take(100) | sum())
+        == (range(1010, 1110) | map([](int x) { return x; }) | sum()));
+  CHECK((range(0, 0) | fold(5, std::plus<>())) == 5);
+
+  auto rest = range(0, 10);
+  CHECK((std::move(rest) | sum()) == 45);
+  CHECK(rest.size_hint().upper == 0);
+}
+
+TEST_CASE("endless ranges") {
+  auto zeros = range(0, 10, 0);
+  CHECK_FALSE(zeros.size_hint().upper.has_value());
+  CHECK(zeros.next() == 0);
+  CHECK(zeros.next() == 0);
+
+  auto front = zeros.split(2);
+  CHECK((std::move(front) | collect<std::vector>()) == std::vector<int>{0, 0});
+  CHECK_FALSE(zeros.size_hint().upper.has_value());
+
+  CHECK((range(0, 10, 0) | take(3) | collect<std::vector>()) == std::vector<int>{0, 0, 0});
+  CHECK((range(7, 10, 0) | take(3) | count()) == 3);
+  CHECK((range(7, 10, 0) | take(3) | sum()) == 21);
+  CHECK((range(7, 10, 0) | take(4) | fold(1, std::plus<>())) == 29);
+
+  CHECK((range(5, 10, -2) | take(3) | collect<std::vector>()) == std::vector<int>{5, 3, 1});
+  CHECK((range(5, 10, -2) | drop(2) | take(2) | sum()) == 0);
+  CHECK((range(5u, 10u, 0u) | take(2) | sum()) == 10u);
+
+  CHECK((range(10, 0, 0) | count()) == 0);
+  CHECK((range(10, 0, -1) | count()) == 0);
+}
+
+TEST_CASE("for each while") {
+  auto it = range(0, 20) | filter([](int x) { return x % 2 == 0; })
+          | map([](int x) { return x / 2; }) | take(5);
+
+  std::vector<int> seen;
+  bool exhausted = it.for_each_while([&](int x) {
+    seen.push_back(x);
+    return x < 2;
+  });
+
+  CHECK(!exhausted);
+  CHECK(seen == std::vector<int>{0, 1, 2});
+  CHECK(it.next() == 3);
+  CHECK(it.for_each_while([](int) { return true; }));
+  CHECK(!it.next().has_value());
+}
+
+TEST_CASE("next batch") {
+  std::vector<int> xs(1000);
+  for (size_t i = 0; i < xs.size(); ++i) { xs[i] = int(i); }
+
+  auto it = iter(xs.data(), xs.size()) | map([](int x) { return 3 * x; })
+          | filter([](int x) { return x % 2 == 0; });
+
+  std::array<int, 300> batch{};
+  CHECK(it.next_batch(batch.data(), batch.size()) == 300);
+  CHECK(batch[0] == 0);
+  CHECK(batch[299] == 3 * 598);
+  CHECK(it.next_batch(batch.data(), batch.size()) == 200);
+  CHECK(batch[199] == 3 * 998);
+  CHECK(it.next_batch(batch.data(), batch.size()) == 0);
+
+  auto ys = range(0, 1000) | map([](int x) { return x + 1; })
+          | collect<std::vector>();
+  CHECK(ys.size() == 1000);
+  CHECK(ys[999] == 1000);
+
+  auto sum = iter(xs) | filter([](int x) { return x % 3 == 0; })
+           | fold(0, std::plus());
+  CHECK(sum == 3 * (333 * 334 / 2));
+}
+
+TEST_CASE("iter_ref") {
+  auto xs = move_int_vec();
+
+  auto doubled = iter_ref(xs) | map([](const MoveInt &x) { return 2 * x.x; })
+               | collect<std::vector>();
+  CHECK(doubled == std::vector<int>{0, 2, 4, 6, 8});
+
+  auto sum = iter_ref(xs) | filter([](const MoveInt &x) { return x.x > 1; })
+           | fold(0, [](int acc, const MoveInt &x) { return acc + x.x; });
+  CHECK(sum == 2 + 3 + 4);
+
+  auto pairs = zip(iter_ref(xs), iter_ref(xs.data() + 1, 4))
+             | map([](auto pair) { return pair.first.get().x * pair.second.get().x; })
+             | collect<std::vector>();
+  CHECK(pairs == std::vector<int>{0, 2, 6, 12});
+
+  auto windows = iter_ref(xs) | window<2>()
+               | map([](auto w) { return w[0].get().x + w[1].get().x; })
+               | collect<std::vector>();
+  CHECK(windows == std::vector<int>{1, 3, 5, 7});
+
+  CHECK(&(iter_ref(xs).next().value().get()) == &xs[0]);
+
+  std::map<std::string, int> m{{"a", 1}, {"b", 2}};
+  auto keys = iter_ref(m) | map([](const std::pair<const std::string, int> &p) { return p.first; })
+            | collect<std::vector>();
+  CHECK(keys == std::vector<std::string>{"a", "b"});
+
+  std::vector<int> ys{1, 2, 3};
+  auto copies = iter_ref(ys) | copied() | collect<std::vector>();
+  CHECK(copies == ys);
+}
+
+template<typename E>
+struct IsMapFilter : std::false_type {};
+
+template<typename F, typename P>
+struct IsMapFilter<expression::MapFilter<F, P>> : std::true_type {};
+
+TEST_CASE("fusion") {
+  auto expr = map([](int x) { return x + 1; })
+            | map([](int x) { return 2 * x; })
+            | filter([](int x) { return x % 3 != 0; })
+            | filter([](int x) { return x > 4; });
+  static_assert(IsMapFilter<decltype(expr)>::value);
+
+  auto ys = iter({0, 1, 2, 3, 4, 5, 6}) | expr | collect<std::vector>();
+  CHECK(ys == std::vector<int>{8, 10, 14});
+
+  auto sliced = enumerate() | drop(1) | drop(2) | take(3) | take(2);
+  using namespace expression;
+  static_assert(std::is_same_v<decltype(sliced),
+                               Composition<Composition<Enumerate, Drop>, Take>>);
+
+  auto zs = range(0, 10) | sliced | map([](auto x) { return x.second; })
+          | collect<std::vector>();
+  CHECK(zs == std::vector<int>{3, 4});
+}
+
+TEST_CASE("random access slice") {
+  std::vector<int> xs{0, 1, 2, 3, 4, 5, 6, 7};
+
+  auto sliced = iter(std::as_const(xs).data(), xs.size()) | slice(2, 3);
+  static_assert(std::is_same_v<decltype(sliced), iterator::Pointer<int>>);
+  CHECK(sliced.size_hint().upper == 3);
+  CHECK((std::move(sliced) | collect<std::vector>()) == std::vector<int>{2, 3, 4});
+
+  auto borrowed = iter(xs) | drop(6) | take(10) | collect<std::vector>();
+  CHECK(borrowed == std::vector<int>{6, 7});
+
+  auto ranged = range(0, 100, 5) | slice(3, 2);
+  static_assert(std::is_same_v<decltype(ranged), iterator::Range<int>>);
+  CHECK((std::move(ranged) | collect<std::vector>()) == std::vector<int>{15, 20});
+
+  auto past_end = iter(std::array<int, 3>{1, 2, 3}) | drop(5) | collect<std::vector>();
+  CHECK(past_end.empty());
+
+  auto owned = iter(move_int_vec()) | slice(1, 2) | collect<std::vector>();
+  CHECK(owned[0] == 1);
+  CHECK(owned[1] == 2);
+  CHECK(owned.size() == 2);
+}
+
+TEST_CASE("par map") {
+  executor::ThreadPool pool(4);
+
+  auto ys = range(0, 10000)
+          | par_map([](int x) { return std::to_string(x * x); }, pool, 64)
+          | collect<std::vector>();
+  REQUIRE(ys.size() == 10000);
+  CHECK(ys[0] == "0");
+  CHECK(ys[3] == "9");
+  CHECK(ys[9999] == "99980001");
+
+  auto it = iter(move_int_vec()) | par_map([](MoveInt x) { return x.x + 1; });
+  CHECK(it.size_hint().lower == 5);
+  CHECK((std::move(it) | collect<std::vector>()) == std::vector<int>{1, 2, 3, 4, 5});
+
+  auto first = open_range(0, 1) | par_map([](int x) { return 2 * x; }, pool, 16)
+             | take(3) | collect<std::vector>();
+  CHECK(first == std::vector<int>{0, 2, 4});
+
+  int sum = range(0, 1000) | par_map([](int x) { return x; }, pool, 1)
+          | fold(0, std::plus<>());
+  CHECK(sum == 499500);
+}
+
+TEST_CASE("par chunk map") {
+  executor::ThreadPool pool(4);
+
+  std::vector<int> xs(10000);
+  std::iota(xs.begin(), xs.end(), 0);
+
+  auto sums = iter(xs) | par_chunk_map(1000, sum(), pool, 3);
+  CHECK(sums.size_hint().lower == 10);
+  auto ys = std::move(sums) | collect<std::vector>();
+  REQUIRE(ys.size() == 10);
+  for (size_t i = 0; i < ys.size(); ++i) { CHECK(ys[i] == 1000000 * int(i) + 499500); }
+
+  std::list<int> zs(xs.begin(), xs.end());
+  CHECK((iter(zs) | par_chunk_map(1000, sum(), pool) | collect<std::vector>()) == ys);
+  CHECK((iter(zs) | par_chunk_map(1000, sum(), pool, 1) | collect<std::vector>()) == ys);
+  CHECK((range(0, 10000) | par_chunk_map(1000, sum()) | collect<std::vector>()) == ys);
+
+  auto strings = iter({std::string("a"), std::string("b"), std::string("c")})
+               | par_chunk_map(2, fold(std::string(), std::plus<>()), pool)
+               | collect<std::vector>();
+  CHECK(strings == std::vector<std::string>{"ab", "c"});
+
+  auto first = open_range(0, 1) | par_chunk_map(4, sum(), pool) | take(3)
+             | collect<std::vector>();
+  CHECK(first == std::vector<int>{6, 22, 38});
+
+  CHECK_FALSE((iter(xs) | par_chunk_map(0, sum(), pool)).next().has_value());
+  CHECK((iter(xs) | par_chunk_map(0, sum(), pool)).size_hint().upper == 0);
+  CHECK((iter(zs) | par_chunk_map(0, sum(), pool) | collect<std::vector>()).empty());
+}
+
+TEST_CASE("split") {
+  auto xs = range(0, 10, 3);
+  auto front = xs.split(2);
+  CHECK((std::move(front) | collect<std::vector>()) == std::vector<int>{0, 3});
+  CHECK((std::move(xs) | collect<std::vector>()) == std::vector<int>{6, 9});
+
+  std::vector<int> ys{1, 2, 3};
+  auto it = iter(ys);
+  auto all = it.split(5);
+  CHECK(it.size_hint().upper == 0);
+  CHECK((std::move(all) | collect<std::vector>()) == ys);
+}
+
+TEST_CASE("par reduce") {
+  executor::ThreadPool pool(4);
+
+  std::vector<long long> xs(100000);
+  std::iota(xs.begin(), xs.end(), 0);
+  auto plus = std::plus<long long>();
+
+  CHECK((iter(xs) | par_reduce(0LL, plus, plus, pool, 1000)) == 4999950000LL);
+  CHECK((iter(xs.data(), xs.size()) | par_reduce(0LL, plus, plus, pool, 7))
+        == 4999950000LL);
+  CHECK((range(0LL, 100000LL) | par_reduce(0LL, plus, plus, pool, 1000))
+        == 4999950000LL);
+
+  std::list<int> ys{1, 2, 3, 4, 5, 6, 7};
+  auto product = iter(ys) | par_reduce(1, std::multiplies<>(), std::multiplies<>(), pool, 2);
+  CHECK(product == 5040);
+
+  auto concat = [](std::string acc, const std::string &x) { return acc + x; };
+  auto words = range(0, 26) | map([](int x) { return std::string(1, char('a' + x)); })
+             | par_reduce(std::string(), concat, concat, pool, 3);
+  CHECK(words == "abcdefghijklmnopqrstuvwxyz");
+
+  auto counted = iter(xs) | filter([](long long x) { return x % 2 == 0; })
+               | par_reduce(size_t(0), [](size_t n, long long) { return n + 1; },
+                            std::plus<size_t>(), pool, 100);
+  CHECK(counted == 50000);
+
+  CHECK((iter(std::vector<int>()) | par_reduce(0, std::plus<>(), std::plus<>(), pool))
+        == 0);
+}
+
+TEST_CASE("reductions") {
+  std::vector<int> xs(1000);
+  std::iota(xs.begin(), xs.end(), -500);
+  std::reverse(xs.begin() + 300, xs.end());
+
+  CHECK((iter(xs) | sum()) == -500);
+  CHECK((iter(xs) | min()) == -500);
+  CHECK((iter(xs) | max()) == 499);
+  CHECK((iter(xs) | minmax()) == std::pair<int, int>(-500, 499));
+  CHECK((iter(xs) | drop(990) | sum()) == -1955);
+  CHECK((iter(xs) | fold(1, std::plus<>())) == -499);
+  CHECK((iter(xs) | fold1(Minimum())) == -500);
+  CHECK((iter(xs) | fold(1000, Maximum())) == 1000);
+  std::array<int, 7> factors{1, 2, 3, 4, 5, 6, 7};
+  CHECK((iter(factors) | fold(2, std::multiplies<int>())) == 10080);
+
+  std::vector<unsigned long long> us{3, 1ull << 63, 7, 2};
+  CHECK((iter(us) | minmax()) == std::pair<unsigned long long, unsigned long long>(2, 1ull << 63));
+
+  std::vector<double> ds(333, 0.5);
+  ds[100] = -3.0;
+  ds[200] = 8.0;
+  CHECK((iter(ds) | sum()) == doctest::Approx(170.5));
+  CHECK((iter(ds) | min()) == -3.0);
+  CHECK((iter(ds) | max()) == 8.0);
+
+  // fold gives the same result for every container, even with NaN
+  ds[0] = std::numeric_limits<double>::quiet_NaN();
+  std::list<double> listed(ds.begin(), ds.end());
+  CHECK((iter(ds) | fold(5.0, Minimum())) == (iter(listed) | fold(5.0, Minimum())));
+  CHECK((iter(ds) | fold(-5.0, Maximum())) == (iter(listed) | fold(-5.0, Maximum())));
+  CHECK((iter(ds) | fold(5.0, Minimum())) == -3.0);
+
+  CHECK((iter(std::vector<float>()) | sum()) == 0.0f);
+  CHECK_FALSE((iter(std::vector<float>()) | max()).has_value());
+
+  CHECK((range(0, 10) | sum()) == 45);
+  CHECK((range(0, 10) | map([](int x) { return 10 - x; }) | minmax())
+        == std::pair<int, int>(1, 10));
+  CHECK((iter({std::string("b"), std::string("a")}) | sum()) == "ba");
+  CHECK_FALSE((range(0, 0) | min()).has_value());
+}
+
+TEST_CASE("kernel dispatch") {
+  using kernel::Isa;
+
+  CHECK(kernel::active_isa() == kernel::best_supported_isa());
+  CHECK(kernel::is_supported(Isa::Scalar));
+
+  std::vector<int> xs(1000);
+  std::iota(xs.begin(), xs.end(), -500);
+  std::reverse(xs.begin(), xs.begin() + 700);
+
+  std::unique_ptr<bool[]> keep(new bool[xs.size()]);
+  std::vector<int> kept;
+  for (size_t i = 0; i < xs.size(); ++i) {
+    keep[i] = xs[i] % 3 == 0;
+    if (keep[i]) { kept.push_back(xs[i]); }
+  }
+
+  for (Isa isa : {Isa::Scalar, Isa::Sse2, Isa::Avx2, Isa::Avx512}) {
+    if (!kernel::use_isa(isa)) { continue; }
+    CAPTURE(kernel::isa_name(isa));
+    CHECK(kernel::active_isa() == isa);
+
+    CHECK(kernel::sum(xs.data(), xs.size()) == -500);
+    CHECK(kernel::minmax(xs.data(), xs.size()) == std::pair<int, int>(-500, 499));
+    CHECK(kernel::count(xs.data(), xs.size(), 7) == 1);
+    CHECK(kernel::find(xs.data(), xs.size(), 199) == 0);
+    CHECK(kernel::find(xs.data(), xs.size(), 250) == 750);
+    CHECK(kernel::find(xs.data(), xs.size(), 1000) == xs.size());
+
+    std::vector<int> out(xs.size());
+    out.resize(kernel::compress(xs.data(), keep.get(), xs.size(), out.data()));
+    CHECK(out == kept);
+  }
+
+  kernel::use_isa(kernel::best_supported_isa());
+}
+
+TEST_CASE("filter compress") {
+  std::vector<long> xs(5000);
+  std::iota(xs.begin(), xs.end(), 0);
+  std::reverse(xs.begin(), xs.begin() + 1234);
+
+  auto is_kept = [](long x) { return x % 7 < 3; };
+  std::vector<long> expected;
+  std::copy_if(xs.begin(), xs.end(), std::back_inserter(expected), is_kept);
+
+  using Compressing = decltype(iter(xs) | filter(is_kept));
+  static_assert(Compressing::compresses);
+
+  for (auto isa : {kernel::Isa::Scalar, kernel::Isa::Avx2, kernel::Isa::Avx512}) {
+    if (!kernel::use_isa(isa)) { continue; }
+    CAPTURE(kernel::isa_name(isa));
+
+    CHECK((iter(xs) | filter(is_kept) | collect<std::vector>()) == expected);
+    CHECK((iter(xs) | drop(1) | filter([](long) { return false; })
+           | collect<std::vector>()).empty());
+
+    auto it = iter(xs.data(), xs.size()) | filter(is_kept);
+    std::array<long, 5> first;
+    CHECK(it.next_batch(first.data(), first.size()) == 5);
+    CHECK(std::equal(first.begin(), first.end(), expected.begin()));
+    CHECK(it.next() == expected[5]);
+  }
+
+  kernel::use_isa(kernel::best_supported_isa());
+}